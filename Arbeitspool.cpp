@@ -0,0 +1,92 @@
+#include "Arbeitspool.h"
+
+#include <algorithm>
+
+///Der Pool, zu dem der aktuelle Thread gehört, und der Index seiner Warteschlange.
+static thread_local const Arbeitspool* eigenerPool = nullptr;
+static thread_local std::size_t eigeneSchlange = 0;
+
+Arbeitspool::Arbeitspool( unsigned threads )
+    : wartend( 0 ), naechsteSchlange( 0 ), beenden( false ) {
+    if( threads == 0 )
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+    for( unsigned t = 0; t < threads; t++ )
+        schlangen.push_back( std::make_unique<Warteschlange>() );
+    for( unsigned t = 0; t < threads; t++ )
+        arbeiterThreads.emplace_back( &Arbeitspool::arbeite, this, t );
+}
+
+Arbeitspool::~Arbeitspool() {
+    {
+        std::lock_guard<std::mutex> wache( schlafSperre );
+        beenden = true;
+    }
+    aufgabeDa.notify_all();
+    for( auto& t : arbeiterThreads )
+        t.join();
+}
+
+void Arbeitspool::fuegeHinzu( std::function<void()> aufgabe ) {
+    const std::size_t index = eigenerPool == this ? eigeneSchlange : naechsteSchlange++ % schlangen.size();
+    ///Die Zählung unter schlafSperre verhindert, dass ein Thread zwischen seiner Prüfung und dem Einschlafen die Benachrichtigung verpasst.
+    ///Sie steigt vor dem Einreihen, damit sie nie kleiner als die Zahl der wartenden Aufgaben ist.
+    {
+        std::lock_guard<std::mutex> wache( schlafSperre );
+        wartend++;
+    }
+    {
+        std::lock_guard<std::mutex> wache( schlangen[index]->sperre );
+        schlangen[index]->aufgaben.push_back( std::move( aufgabe ) );
+    }
+    aufgabeDa.notify_one();
+}
+
+bool Arbeitspool::fuehreEineAus() {
+    std::function<void()> aufgabe;
+    if( !nimm( eigenerPool == this ? eigeneSchlange : schlangen.size(), aufgabe ) )
+        return false;
+    aufgabe();
+    return true;
+}
+
+bool Arbeitspool::nimm( std::size_t eigene, std::function<void()>& aufgabe ) {
+    if( wartend.load() == 0 )
+        return false;
+    if( eigene < schlangen.size() ) {
+        Warteschlange& schlange = *schlangen[eigene];
+        std::lock_guard<std::mutex> wache( schlange.sperre );
+        if( !schlange.aufgaben.empty() ) {
+            aufgabe = std::move( schlange.aufgaben.back() );
+            schlange.aufgaben.pop_back();
+            wartend--;
+            return true;
+        }
+    }
+    ///Gestohlen wird vorne, also die älteste und damit meist größte Aufgabe.
+    for( std::size_t i = 1; i <= schlangen.size(); i++ ) {
+        Warteschlange& schlange = *schlangen[( eigene + i ) % schlangen.size()];
+        std::lock_guard<std::mutex> wache( schlange.sperre );
+        if( !schlange.aufgaben.empty() ) {
+            aufgabe = std::move( schlange.aufgaben.front() );
+            schlange.aufgaben.pop_front();
+            wartend--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Arbeitspool::arbeite( std::size_t index ) {
+    eigenerPool = this;
+    eigeneSchlange = index;
+    for( ;; ) {
+        if( fuehreEineAus() )
+            continue;
+        std::unique_lock<std::mutex> wache( schlafSperre );
+        aufgabeDa.wait( wache, [this]() {
+            return beenden || wartend.load() > 0;
+        } );
+        if( beenden && wartend.load() == 0 )
+            return;
+    }
+}
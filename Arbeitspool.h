@@ -0,0 +1,82 @@
+#ifndef ARBEITSPOOL_H
+#define ARBEITSPOOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+/**
+    @brief Ein Pool von Arbeitsthreads, die sich gegenseitig Aufgaben stehlen (work stealing).
+    Jeder Arbeitsthread hat eine eigene Warteschlange. Eine Aufgabe, die ein Arbeitsthread hinzufügt, landet hinten in seiner eigenen Schlange und wird von ihm als nächstes ausgeführt (LIFO).
+    Ist die eigene Schlange leer, nimmt er die älteste Aufgabe vorne aus der Schlange eines anderen Threads. So bleiben zusammengehörige Teilaufgaben auf einem Thread,
+    und nur große, alte Aufgaben wandern zu untätigen Threads.
+    Auch ein Thread, der nicht zum Pool gehört, kann mit fuehreEineAus mitarbeiten, z.B. während er auf eine Teilaufgabe wartet.
+ */
+class Arbeitspool {
+    public:
+        /**
+            @brief Konstruktor: Startet die Arbeitsthreads.
+            @param threads: Anzahl der Arbeitsthreads, 0 = Anzahl der Prozessorkerne
+         */
+        explicit Arbeitspool( unsigned threads = 0 );
+        /**
+            @brief Destruktor: Wartet, bis alle Aufgaben ausgeführt sind, und beendet die Arbeitsthreads.
+         */
+        ~Arbeitspool();
+        Arbeitspool( const Arbeitspool& ) = delete;
+        Arbeitspool& operator = ( const Arbeitspool& ) = delete;
+
+        /**
+            @brief Fügt eine Aufgabe hinzu.
+            Aus einem Arbeitsthread heraus kommt sie in dessen eigene Schlange, sonst reihum in die Schlangen der Arbeitsthreads.
+            @param aufgabe: Die Aufgabe, sie darf keine Exception werfen
+         */
+        void fuegeHinzu( std::function<void()> aufgabe );
+
+        /**
+            @brief Führt eine wartende Aufgabe auf dem aufrufenden Thread aus.
+            Ein Arbeitsthread nimmt zuerst die neueste Aufgabe seiner eigenen Schlange, alle anderen Threads stehlen die älteste Aufgabe einer beliebigen Schlange.
+            @returns False, wenn keine Aufgabe wartet
+         */
+        bool fuehreEineAus();
+
+        unsigned getAnzahlThreads() const {
+            return static_cast<unsigned>( arbeiterThreads.size() );
+        }
+
+    private:
+        struct Warteschlange {
+            std::mutex sperre;
+            std::deque<std::function<void()>> aufgaben;
+        };
+
+        /**
+            @brief Schleife eines Arbeitsthreads: Führt Aufgaben aus und schläft, solange keine wartet.
+            @param index: Index der eigenen Warteschlange
+         */
+        void arbeite( std::size_t index );
+        /**
+            @brief Nimmt eine Aufgabe aus den Schlangen, beginnend mit der Schlange eigene.
+            @param eigene: Index der eigenen Schlange, getAnzahlThreads() für Threads außerhalb des Pools
+            @param aufgabe: Die genommene Aufgabe
+            @returns False, wenn alle Schlangen leer sind
+         */
+        bool nimm( std::size_t eigene, std::function<void()>& aufgabe );
+
+        std::vector<std::unique_ptr<Warteschlange>> schlangen;
+        std::vector<std::thread> arbeiterThreads;
+        ///Anzahl der Aufgaben in allen Schlangen, damit schlafende Threads kein Hinzufügen verpassen
+        std::atomic<std::size_t> wartend;
+        std::atomic<std::size_t> naechsteSchlange;
+        bool beenden;
+        std::mutex schlafSperre;
+        std::condition_variable aufgabeDa;
+};
+
+#endif // ARBEITSPOOL_H
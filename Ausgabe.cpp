@@ -0,0 +1,65 @@
+#include "Ausgabe.h"
+
+#include <cerrno>
+#include <unistd.h>
+
+std::to_chars_result schreibeZahl( char* anfang, char* ende, __int128 zahl ) {
+    unsigned __int128 rest = zahl < 0 ? -static_cast<unsigned __int128>( zahl ) : static_cast<unsigned __int128>( zahl );
+    char ziffern[40];
+    char* ziffernEnde = ziffern + sizeof( ziffern );
+    char* ziffernAnfang = ziffernEnde;
+    do {
+        *--ziffernAnfang = static_cast<char>( '0' + rest % 10 );
+        rest /= 10;
+    } while( rest != 0 );
+    if( zahl < 0 )
+        *--ziffernAnfang = '-';
+    if( ende - anfang < ziffernEnde - ziffernAnfang )
+        return { ende, std::errc::value_too_large };
+    std::memcpy( anfang, ziffernAnfang, ziffernEnde - ziffernAnfang );
+    return { anfang + ( ziffernEnde - ziffernAnfang ), std::errc() };
+}
+
+std::to_chars_result schreibeBruch( char* anfang, char* ende, const GeprueftesErgebnis& ergebnis ) {
+    return std::visit( [anfang, ende]( const auto & b ) {
+        return schreibeBruch( anfang, ende, b );
+    }, ergebnis );
+}
+
+Ausgabepuffer::Ausgabepuffer( int dateideskriptor, bool zeilenweise, std::size_t blockgroesse )
+    : dateideskriptor( dateideskriptor ), zeilenweise( zeilenweise ), puffer( blockgroesse, '\0' ), belegt( 0 ) {
+}
+
+Ausgabepuffer::~Ausgabepuffer() {
+    leere();
+}
+
+void Ausgabepuffer::schreibe( std::string_view text ) {
+    if( text.size() > puffer.size() - belegt )
+        leere();
+    if( text.size() >= puffer.size() ) {
+        schreibeDirekt( text.data(), text.size() );
+        return;
+    }
+    std::memcpy( puffer.data() + belegt, text.data(), text.size() );
+    belegt += text.size();
+}
+
+void Ausgabepuffer::leere() {
+    schreibeDirekt( puffer.data(), belegt );
+    belegt = 0;
+}
+
+void Ausgabepuffer::schreibeDirekt( const char* daten, std::size_t laenge ) {
+    while( laenge > 0 ) {
+        const ssize_t geschrieben = write( dateideskriptor, daten, laenge );
+        if( geschrieben < 0 ) {
+            if( errno == EINTR )
+                continue;
+            ///Ist das Ziel nicht mehr beschreibbar (z.B. geschlossene Pipe), wird die restliche Ausgabe verworfen.
+            return;
+        }
+        daten += geschrieben;
+        laenge -= geschrieben;
+    }
+}
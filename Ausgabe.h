@@ -0,0 +1,187 @@
+#ifndef AUSGABE_H
+#define AUSGABE_H
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <type_traits>
+#include <cstring>
+
+#include "Bruchberechner.h"
+
+/**
+    @brief Schreibt eine Zahl in den Bereich [anfang, ende).
+    Ganzzahlen werden mit std::to_chars geschrieben. Gleitkommazahlen werden wie von std::ostream mit 6 signifikanten Stellen geschrieben, damit die Ausgabe der bisherigen entspricht.
+    Für andere Typen wird als Rückfallebene der Operator << genutzt.
+    @arg T: Zahlentyp
+    @param anfang: Anfang des Puffers
+    @param ende: Ende des Puffers
+    @param zahl: Die Zahl
+    @returns Zeiger hinter das letzte geschriebene Zeichen, errc::value_too_large falls der Puffer zu klein ist
+ */
+template <typename T> std::to_chars_result schreibeZahl( char* anfang, char* ende, const T& zahl ) {
+    if constexpr( std::is_integral<T>::value )
+        return std::to_chars( anfang, ende, zahl );
+    else if constexpr( std::is_floating_point<T>::value )
+        return std::to_chars( anfang, ende, zahl, std::chars_format::general, 6 );
+    else {
+        std::ostringstream os;
+        os << zahl;
+        const std::string text = os.str();
+        if( static_cast<std::size_t>( ende - anfang ) < text.size() )
+            return { ende, std::errc::value_too_large };
+        std::memcpy( anfang, text.data(), text.size() );
+        return { anfang + text.size(), std::errc() };
+    }
+}
+
+/**
+    @brief Schreibt eine 128-Bit-Zahl in den Bereich [anfang, ende).
+ */
+std::to_chars_result schreibeZahl( char* anfang, char* ende, __int128 zahl );
+
+/**
+    @brief Schreibt eine Langzahl in den Bereich [anfang, ende).
+ */
+inline std::to_chars_result schreibeZahl( char* anfang, char* ende, const Langzahl& zahl ) {
+    return zahl.schreibeDezimal( anfang, ende );
+}
+
+/**
+    @brief Schreibt eine überlaufgeprüfte Zahl in den Bereich [anfang, ende).
+    @arg T: verpackter Ganzzahltyp
+ */
+template <typename T> std::to_chars_result schreibeZahl( char* anfang, char* ende, const Geprueft<T>& zahl ) {
+    return schreibeZahl( anfang, ende, zahl.getWert() );
+}
+
+/**
+    @brief Schreibt einen Bruch in den Bereich [anfang, ende).
+    Das Format entspricht dem Operator << für Brüche: "[Zähler]/[Nenner]", bzw. nur "[Zähler]", wenn der Nenner 1 ist.
+    Der Puffer wird vom Aufrufer bereitgestellt, für eingebaute Zahlentypen wird kein Speicher angefordert.
+    @arg T: Speicherdatentyp von Zähler und Nenner
+    @arg K: Kürzungsstrategie
+    @param anfang: Anfang des Puffers
+    @param ende: Ende des Puffers
+    @param b: Der Bruch
+    @returns Zeiger hinter das letzte geschriebene Zeichen, errc::value_too_large falls der Puffer zu klein ist
+ */
+template <typename T, typename K> std::to_chars_result schreibeBruch( char* anfang, char* ende, const Bruch<T, K>& b ) {
+    auto ergebnis = schreibeZahl( anfang, ende, b.getZaehler() );
+    if( ergebnis.ec != std::errc() || b.getNenner() == 1 )
+        return ergebnis;
+    if( ergebnis.ptr == ende )
+        return { ende, std::errc::value_too_large };
+    *ergebnis.ptr++ = '/';
+    return schreibeZahl( ergebnis.ptr, ende, b.getNenner() );
+}
+
+/**
+    @brief Schreibt ein Ergebnis mit Überlaufschutz in den Bereich [anfang, ende).
+ */
+std::to_chars_result schreibeBruch( char* anfang, char* ende, const GeprueftesErgebnis& ergebnis );
+
+/**
+    @brief Hängt einen Bruch an text an.
+    Der Bruch wird über einen Puffer auf dem Stack geschrieben. Nur wenn er dort nicht hineinpasst (große Langzahlen), wird ein größerer Puffer angelegt.
+    @arg B: Bruch<T, K> oder GeprueftesErgebnis
+    @param text: Die Zeichenkette, an die angehängt wird
+    @param b: Der Bruch
+ */
+template <typename B> void haengeBruchAn( std::string& text, const B& b ) {
+    char puffer[128];
+    const auto ergebnis = schreibeBruch( puffer, puffer + sizeof( puffer ), b );
+    if( ergebnis.ec == std::errc() ) {
+        text.append( puffer, ergebnis.ptr );
+        return;
+    }
+    std::string grosserPuffer( 1 << 10, '\0' );
+    for( ;; ) {
+        const auto ergebnisGross = schreibeBruch( grosserPuffer.data(), grosserPuffer.data() + grosserPuffer.size(), b );
+        if( ergebnisGross.ec == std::errc() ) {
+            text.append( grosserPuffer.data(), ergebnisGross.ptr );
+            return;
+        }
+        grosserPuffer.resize( 2 * grosserPuffer.size() );
+    }
+}
+
+/**
+    @brief Gepufferte Ausgabe in einen Dateideskriptor.
+    Der Puffer sammelt die Ausgaben in einem Block und schreibt sie erst mit einem Systemaufruf, wenn der Block voll ist oder der Puffer zerstört wird.
+    Im zeilenweisen Modus (für die interaktive Nutzung) wird nach jeder fertigen Zeile geschrieben, so wie bisher mit std::endl.
+ */
+class Ausgabepuffer {
+    public:
+        /**
+            @brief Konstruktor: Legt den Puffer an.
+            @param dateideskriptor: Ziel der Ausgabe, z.B. 1 für stdout
+            @param zeilenweise: True, wenn nach jeder fertigen Zeile geschrieben werden soll
+            @param blockgroesse: Größe des Puffers in Bytes
+         */
+        explicit Ausgabepuffer( int dateideskriptor, bool zeilenweise = false, std::size_t blockgroesse = 1 << 16 );
+
+        /**
+            @brief Destruktor: Schreibt den restlichen Inhalt des Puffers.
+         */
+        ~Ausgabepuffer();
+
+        Ausgabepuffer( const Ausgabepuffer& ) = delete;
+        Ausgabepuffer& operator = ( const Ausgabepuffer& ) = delete;
+
+        /**
+            @brief Hängt text an den Puffer an.
+            Ist text größer als der Puffer, wird er direkt geschrieben.
+            @param text: Der Text
+         */
+        void schreibe( std::string_view text );
+
+        /**
+            @brief Schreibt einen Bruch direkt in den Puffer.
+            @arg B: Bruch<T, K> oder GeprueftesErgebnis
+            @param b: Der Bruch
+         */
+        template <typename B> void schreibeBruch( const B& b ) {
+            auto ergebnis = ::schreibeBruch( puffer.data() + belegt, puffer.data() + puffer.size(), b );
+            if( ergebnis.ec != std::errc() ) {
+                leere();
+                ergebnis = ::schreibeBruch( puffer.data(), puffer.data() + puffer.size(), b );
+            }
+            if( ergebnis.ec == std::errc() ) {
+                belegt = ergebnis.ptr - puffer.data();
+                return;
+            }
+            ///Der Bruch ist größer als der ganze Puffer.
+            std::string text;
+            haengeBruchAn( text, b );
+            schreibe( text );
+        }
+
+        /**
+            @brief Schließt eine Zeile ab.
+            Im zeilenweisen Modus wird der Puffer jetzt geschrieben.
+         */
+        void zeileFertig() {
+            if( zeilenweise )
+                leere();
+        }
+
+        /**
+            @brief Schreibt den Inhalt des Puffers in den Dateideskriptor.
+         */
+        void leere();
+
+    private:
+        /**
+            @brief Schreibt den Bereich vollständig, auch wenn write ihn in mehreren Teilen annimmt.
+         */
+        void schreibeDirekt( const char* daten, std::size_t laenge );
+
+        int dateideskriptor;
+        bool zeilenweise;
+        std::string puffer;
+        std::size_t belegt;
+};
+
+#endif // AUSGABE_H
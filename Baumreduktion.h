@@ -0,0 +1,165 @@
+#ifndef BAUMREDUKTION_H
+#define BAUMREDUKTION_H
+
+#include <vector>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
+#include "Bruch.h"
+#include "Arbeitspool.h"
+
+/**
+    @brief Verbindet zwei Teilergebnisse einer Baumsumme.
+    Addiert wird wie in summiere über das kgV der Nenner, danach wird gekürzt. So bleiben die Teilsummen jeder Ebene so klein wie möglich.
+ */
+struct BaumSumme {
+    template <typename T, typename K> static Bruch<T, K> verbinde( const Bruch<T, K>& a, const Bruch<T, K>& b ) {
+        const Bruch<T, K> summanden[] = { a, b };
+        Bruch<T, K> summe = summiere( summanden, 2 );
+        summe.kuerzeBruch();
+        return summe;
+    }
+    template <typename T, typename K> static Bruch<T, K> neutral() {
+        return Bruch<T, K>( 0 );
+    }
+};
+
+/**
+    @brief Verbindet zwei Teilergebnisse eines Baumprodukts.
+    Da die Blätter gekürzt werden, ist jedes Teilprodukt des Operators * bereits gekürzt. Wo er nicht über Kreuz kürzt (vorzeichenlose Typen), wird das Produkt danach gekürzt.
+ */
+struct BaumProdukt {
+    template <typename T, typename K> static Bruch<T, K> verbinde( const Bruch<T, K>& a, const Bruch<T, K>& b ) {
+        Bruch<T, KuerzeNie> produkt = Bruch<T, KuerzeNie>( a.getNenner(), a.getZaehler() ) * Bruch<T, KuerzeNie>( b.getNenner(), b.getZaehler() );
+        if constexpr( std::is_unsigned<T>::value )
+            produkt.kuerzeBruch();
+        return Bruch<T, K>( produkt.getNenner(), produkt.getZaehler() );
+    }
+    template <typename T, typename K> static Bruch<T, K> neutral() {
+        return Bruch<T, K>( 1 );
+    }
+};
+
+/**
+    @brief Reduziert brueche[0, anzahl) als balancierten Binärbaum.
+    Die Folge wird halbiert, beide Hälften werden reduziert und verbunden. Anders als bei einer Kette a + b + c + ... werden so immer etwa gleich große Operanden verbunden.
+    Ist pool nicht nullptr und die Folge länger als blockgroesse, wird die rechte Hälfte als Aufgabe in den Pool gestellt und die linke selbst berechnet.
+    Während der Thread auf die rechte Hälfte wartet, führt er andere Aufgaben des Pools aus, meist die eigene rechte Hälfte.
+    @arg V: BaumSumme oder BaumProdukt
+    @param brueche: Die gekürzten Operanden
+    @param anzahl: Anzahl der Operanden, mindestens 1
+    @param pool: Der Arbeitspool oder nullptr für eine Berechnung ohne Threads
+    @param blockgroesse: Länge, bis zu der ein Teilbaum ohne weitere Aufgaben berechnet wird
+    @returns Das gekürzte Ergebnis
+ */
+template <typename V, typename T, typename K> Bruch<T, K> reduziereTeilbaum( const Bruch<T, K>* brueche, std::size_t anzahl, Arbeitspool* pool, std::size_t blockgroesse ) {
+    if( anzahl == 1 )
+        return brueche[0];
+    const std::size_t mitte = anzahl / 2;
+    if( pool == nullptr || anzahl <= blockgroesse )
+        return V::verbinde( reduziereTeilbaum<V>( brueche, mitte, nullptr, blockgroesse ),
+                            reduziereTeilbaum<V>( brueche + mitte, anzahl - mitte, nullptr, blockgroesse ) );
+    Bruch<T, K> rechts;
+    std::exception_ptr fehlerRechts;
+    std::atomic<bool> fertig( false );
+    pool->fuegeHinzu( [&]() {
+        try {
+            rechts = reduziereTeilbaum<V>( brueche + mitte, anzahl - mitte, pool, blockgroesse );
+        } catch( ... ) {
+            fehlerRechts = std::current_exception();
+        }
+        fertig.store( true, std::memory_order_release );
+    } );
+    ///Die Aufgabe greift auf die lokalen Variablen zu, auf sie muss also auch bei einer Exception in der linken Hälfte gewartet werden.
+    Bruch<T, K> links;
+    std::exception_ptr fehlerLinks;
+    try {
+        links = reduziereTeilbaum<V>( brueche, mitte, pool, blockgroesse );
+    } catch( ... ) {
+        fehlerLinks = std::current_exception();
+    }
+    while( !fertig.load( std::memory_order_acquire ) )
+        if( !pool->fuehreEineAus() )
+            std::this_thread::yield();
+    if( fehlerLinks )
+        std::rethrow_exception( fehlerLinks );
+    if( fehlerRechts )
+        std::rethrow_exception( fehlerRechts );
+    return V::verbinde( links, rechts );
+}
+
+/**
+    @brief Reduziert anzahl Brüche als balancierten Baum, auf Wunsch parallel.
+    Die Blätter werden gekürzt und jedes Teilergebnis wird auf jeder Ebene gekürzt. Das funktioniert für eingebaute Typen, Geprueft und Langzahl gleichermaßen.
+    Die Kürzungsstrategie wird erst auf das fertige Ergebnis angewandt.
+    @arg V: BaumSumme oder BaumProdukt
+    @param brueche: Die Operanden
+    @param anzahl: Anzahl der Operanden
+    @param pool: Der Arbeitspool oder nullptr für eine Berechnung ohne Threads
+    @param blockgroesse: Länge, bis zu der ein Teilbaum auf einem Thread berechnet wird
+    @returns Das Ergebnis, 0 bzw. 1 für anzahl = 0
+ */
+template <typename V, typename T, typename K> Bruch<T, K> reduziereBaum( const Bruch<T, K>* brueche, std::size_t anzahl, Arbeitspool* pool, std::size_t blockgroesse ) {
+    static_assert( !std::is_floating_point<T>::value, "Die Baumreduktion kürzt auf jeder Ebene und ist nur für Ganzzahltypen gedacht." );
+    if( anzahl == 0 )
+        return V::template neutral<T, K>();
+    ///Gekürzte Blätter sind nötig, damit das Kürzen über Kreuz beim Produkt ein gekürztes Ergebnis liefert.
+    std::vector<Bruch<T, K>> blaetter( brueche, brueche + anzahl );
+    for( auto& b : blaetter )
+        b.kuerzeBruch();
+    Bruch<T, K> ergebnis = reduziereTeilbaum<V>( blaetter.data(), anzahl, pool, std::max<std::size_t>( 2, blockgroesse ) );
+    K::nachOperation( ergebnis );
+    return ergebnis;
+}
+
+/**
+    @brief Summiert anzahl Brüche als balancierten Baum auf den Threads von pool.
+    Für sehr viele Summanden bleiben die Zwischensummen deutlich kleiner als bei einer Kette von Additionen oder bei summiere, deren Akkumulator mit jedem Summanden wächst.
+    @param brueche: Die Summanden
+    @param anzahl: Anzahl der Summanden
+    @param pool: Der Arbeitspool
+    @param blockgroesse: Länge, bis zu der ein Teilbaum auf einem Thread berechnet wird, default = 256
+    @returns Die gekürzte Summe
+ */
+template <typename T, typename K> Bruch<T, K> summiereBaum( const Bruch<T, K>* brueche, std::size_t anzahl, Arbeitspool& pool, std::size_t blockgroesse = 256 ) {
+    return reduziereBaum<BaumSumme>( brueche, anzahl, &pool, blockgroesse );
+}
+
+/**
+    @brief Summiert anzahl Brüche als balancierten Baum auf einem eigenen Arbeitspool.
+    @param threads: Anzahl der Arbeitsthreads, 0 = Anzahl der Prozessorkerne, 1 = ohne Threads
+ */
+template <typename T, typename K> Bruch<T, K> summiereBaum( const Bruch<T, K>* brueche, std::size_t anzahl, unsigned threads = 0 ) {
+    if( threads == 1 )
+        return reduziereBaum<BaumSumme>( brueche, anzahl, nullptr, anzahl );
+    Arbeitspool pool( threads );
+    return summiereBaum( brueche, anzahl, pool );
+}
+
+/**
+    @brief Multipliziert anzahl Brüche als balancierten Baum auf den Threads von pool.
+    @param brueche: Die Faktoren
+    @param anzahl: Anzahl der Faktoren
+    @param pool: Der Arbeitspool
+    @param blockgroesse: Länge, bis zu der ein Teilbaum auf einem Thread berechnet wird, default = 256
+    @returns Das gekürzte Produkt
+ */
+template <typename T, typename K> Bruch<T, K> multipliziereBaum( const Bruch<T, K>* brueche, std::size_t anzahl, Arbeitspool& pool, std::size_t blockgroesse = 256 ) {
+    return reduziereBaum<BaumProdukt>( brueche, anzahl, &pool, blockgroesse );
+}
+
+/**
+    @brief Multipliziert anzahl Brüche als balancierten Baum auf einem eigenen Arbeitspool.
+    @param threads: Anzahl der Arbeitsthreads, 0 = Anzahl der Prozessorkerne, 1 = ohne Threads
+ */
+template <typename T, typename K> Bruch<T, K> multipliziereBaum( const Bruch<T, K>* brueche, std::size_t anzahl, unsigned threads = 0 ) {
+    if( threads == 1 )
+        return reduziereBaum<BaumProdukt>( brueche, anzahl, nullptr, anzahl );
+    Arbeitspool pool( threads );
+    return multipliziereBaum( brueche, anzahl, pool );
+}
+
+#endif // BAUMREDUKTION_H
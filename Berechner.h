@@ -5,6 +5,11 @@
 #include <tuple>
 #include <utility>
 #include <string>
+#include <string_view>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Termergebnis.h"
 
 /**
     @brief Entfernt ein Objekt von zahlenstapel und gibt es zurück.
@@ -86,6 +91,206 @@ template <typename T, typename ... Args> void berechneOperation( std::vector<T>&
     zahlenstapel.push_back( b );
 }
 
+/**
+    @brief Bestimmt die Parametertypen eines Funktionsobjekts (z.B. eines Lambdas) aus seinem operator().
+    Generische Lambdas (mit auto-Parametern) haben keine feste Stelligkeit und werden nicht unterstützt.
+    @arg F: Typ des Funktionsobjekts
+ */
+template <typename F> struct Signatur : Signatur<decltype( &F::operator() )> {};
+template <typename R, typename C, typename ... Args> struct Signatur<R ( C::* )( Args ... ) const> {
+    using Argumente = std::tuple<std::decay_t<Args> ...>;
+    static constexpr int stelligkeit = sizeof ...( Args );
+};
+template <typename R, typename ... Args> struct Signatur<R ( * )( Args ... )> {
+    using Argumente = std::tuple<std::decay_t<Args> ...>;
+    static constexpr int stelligkeit = sizeof ...( Args );
+};
+
+/**
+    @brief Prüft, ob F eine Stapeloperation ist.
+    Eine Stapeloperation hat keine feste Stelligkeit. Sie erhält den ganzen Zahlenstapel als Zeiger auf das unterste Element und dessen Höhe und gibt einen Fehlercode zurück.
+    Sie darf Zahlen entfernen (hoehe verkleinern) und die verbleibenden Plätze überschreiben, aber keine Zahlen hinzufügen. So lassen sich Rechenzeichen mit veränderlicher Stellenzahl
+    und Rechenzeichen, die ihre Operanden prüfen müssen (z.B. die Division auf 0), auf jedem Stapel umsetzen, ohne Exceptions zu werfen.
+    @arg F: Typ des Funktionsobjekts
+    @arg T: Datentyp der Zahlen
+ */
+template <typename F, typename T> using IstStapeloperation = std::is_invocable_r<Fehlercode, const F&, T*, std::size_t&>;
+
+/**
+    @brief Liest die Argumente in einen Tuple mit den Typen aus dem Tuple Argumente.
+    Hilfsklasse, um das Parameterpaket eines Tuple-Typs für Ausleser zu entpacken.
+ */
+template <typename T, typename Argumente> struct TupleAusleser;
+template <typename T, typename ... Args> struct TupleAusleser<T, std::tuple<Args ...>> {
+    static void leseTupleAusVektor( std::vector<T>& zahlenstapel, std::tuple<Args ...>& args ) {
+        Ausleser < T, sizeof ...( Args ) - 1, Args ... >::leseTupleAusVektor( zahlenstapel, args );
+    }
+};
+
+/**
+    @brief Berechnet das Ergebnis aus dem Funktionsobjekt operation und den obersten Zahlen aus zahlenstapel.
+    Wie berechneOperation für Funktionszeiger, aber für Funktionsobjekte wie Lambdas. Die Stelligkeit wird aus dem operator() bestimmt.
+    Eine Stapeloperation (siehe IstStapeloperation) wird direkt auf zahlenstapel angewandt, ihr Fehlercode wird als Exception geworfen wie bei wirfFehler.
+    Da der Typ von operation zur Kompilierzeit feststeht, kann der Compiler die Operation einsetzen, statt sie über einen Zeiger aufzurufen.
+    @arg T: Datentyp, mit dem gerechnet werden soll
+    @arg F: Typ des Funktionsobjekts
+    @param zahlenstapel: Der vektor mit den zu berechnenden Zahlen
+    @param operation: Die Berechnung die auf die Zahlen aus den zahlenstapel angewand werden soll
+    @param name: Das Rechenzeichen, nur für die Fehlermeldung einer Stapeloperation. Ist es leer, wird die feste Meldung zum Fehlercode genutzt.
+    @param stellen: Die Stellenzahl einer Stapeloperation für die Fehlermeldung, 0 wenn sie nicht feststeht
+ */
+template <typename T, typename F, typename = std::enable_if_t<std::is_class<F>::value>>
+void berechneOperation( std::vector<T>& zahlenstapel, const F& operation, std::string_view name = "", std::size_t stellen = 0 ) {
+    if constexpr( IstStapeloperation<F, T>::value ) {
+        std::size_t hoehe = zahlenstapel.size();
+        const Fehlercode fehler = operation( zahlenstapel.data(), hoehe );
+        if( fehler != Fehlercode::KeinFehler )
+            wirfFehler( fehler, name, 0, stellen );
+        zahlenstapel.erase( zahlenstapel.begin() + hoehe, zahlenstapel.end() );
+    } else {
+        constexpr int anzahlArgs = Signatur<F>::stelligkeit;
+        if( anzahlArgs > zahlenstapel.size() )
+            throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung mit " + std::to_string( anzahlArgs ) + " Stellen." );
+        typename Signatur<F>::Argumente args;
+        TupleAusleser<T, typename Signatur<F>::Argumente>::leseTupleAusVektor( zahlenstapel, args );
+        T b = std::apply( operation, args );
+        zahlenstapel.push_back( b );
+    }
+}
+
+/**
+    @brief Ein Eintrag einer Operatortabelle: der Name des Rechenzeichens und die Rechenoperation.
+    @arg F: Typ der Rechenoperation, ein Funktionsobjekt mit fester Stelligkeit oder eine Stapeloperation (siehe IstStapeloperation)
+ */
+template <typename F> struct Operator {
+    std::string_view name;
+    F operation;
+    ///Nur für Stapeloperationen: die Stellenzahl für Fehlermeldungen, 0 wenn sie nicht feststeht (siehe getStellen)
+    std::size_t stellen;
+};
+
+/**
+    @brief Erzeugt einen Eintrag für eine Operatortabelle.
+    @arg F: Typ der Rechenoperation
+    @param name: Das Rechenzeichen, es darf aus mehreren Zeichen bestehen (z.B. "max"), aber nicht mit einer Ziffer beginnen
+    @param operation: Die Rechenoperation, z.B. ein Lambda
+    @param stellen: Nur für Stapeloperationen mit fester Stellenzahl (z.B. die Division): die Stellenzahl für Fehlermeldungen, default = 0 (veränderlich)
+    @returns Den Eintrag
+    @pre name ist nicht leer
+ */
+template <typename F> constexpr Operator<F> definiereOperator( std::string_view name, F operation, std::size_t stellen = 0 ) {
+    return { name, operation, stellen };
+}
+
+/**
+    @brief Gibt die Stellenzahl eines Eintrags für Fehlermeldungen zurück.
+    @arg T: Datentyp der Zahlen
+    @arg F: Typ der Rechenoperation
+    @param eintrag: Der Eintrag der Operatortabelle
+    @returns Die Stelligkeit der Operation, für eine Stapeloperation die beim Definieren angegebene Stellenzahl
+ */
+template <typename T, typename F> constexpr std::size_t getStellen( const Operator<F>& eintrag ) {
+    if constexpr( IstStapeloperation<F, T>::value )
+        return eintrag.stellen;
+    else
+        return Signatur<F>::stelligkeit;
+}
+
+/**
+    @brief Eine zur Kompilierzeit festgelegte Tabelle von Rechenzeichen.
+    Jeder Eintrag ordnet einem Namen eine Rechenoperation fester Stelligkeit oder eine Stapeloperation zu. Wie sie angewandt wird, entscheidet der Aufrufer (siehe finde),
+    berechneNaechstenTerm nutzt berechneOperation auf einem std::vector, der Termrechner arbeitet direkt auf seinem eigenen Stapel.
+    Die Einträge liegen in einem std::tuple. Gesucht wird mit einem Fold-Ausdruck über alle Einträge, also ohne Sprungtabelle und ohne Funktionszeiger,
+    sodass die Operationen direkt eingesetzt werden können. Bei mehreren passenden Namen gewinnt der längste, bei gleich langen der zuletzt eingetragene.
+    @arg Operatoren: Typen der Einträge (Operator<F>)
+ */
+template <typename ... Operatoren> class Operatortabelle {
+    public:
+        constexpr explicit Operatortabelle( Operatoren ... operatoren )
+            : operatoren( operatoren ... ) {
+        }
+
+        /**
+            @brief Gibt eine neue Tabelle mit einem zusätzlichen Eintrag zurück.
+            Ein Eintrag mit demselben Namen wie ein vorhandener ersetzt diesen, da von gleich langen Namen der letzte gewinnt.
+            @arg F: Typ der Rechenoperation
+            @param op: Der neue Eintrag
+            @returns Die erweiterte Tabelle
+         */
+        template <typename F> constexpr Operatortabelle<Operatoren ..., Operator<F>> erweitere( Operator<F> op ) const {
+            return std::apply( [&op]( const Operatoren& ... vorhandene ) {
+                return Operatortabelle<Operatoren ..., Operator<F>>( vorhandene ..., op );
+            }, operatoren );
+        }
+
+        /**
+            @brief Sucht das längste Rechenzeichen, mit dem text beginnt.
+            @param text: Der Text ab dem Rechenzeichen
+            @returns Die Länge des Namens, 0 wenn kein Rechenzeichen passt
+         */
+        constexpr std::size_t findeLaenge( std::string_view text ) const {
+            return suche( text, std::index_sequence_for<Operatoren ...>() ).second;
+        }
+
+        /**
+            @brief Testet, ob text der Anfang eines längeren Namens der Tabelle ist.
+            Wird ein Term in Stücken gelesen, kann das Rechenzeichen dann im nächsten Stück weitergehen.
+            @param text: Der Text ab dem Rechenzeichen
+            @returns True, wenn ein Name mit text beginnt und länger ist
+         */
+        constexpr bool istNamensanfang( std::string_view text ) const {
+            return std::apply( [text]( const Operatoren& ... eintraege ) {
+                return ( ( eintraege.name.size() > text.size() && eintraege.name.substr( 0, text.size() ) == text ) || ... );
+            }, operatoren );
+        }
+
+        /**
+            @brief Sucht das längste Rechenzeichen, mit dem text beginnt, und übergibt seinen Eintrag an besucher.
+            Der Eintrag wird mit seinem eigenen Typ übergeben, besucher kann die Operation also direkt einsetzen und nach ihrer Art (feste Stelligkeit oder Stapeloperation) unterscheiden.
+            @arg Besucher: Funktionsobjekt, das mit jedem Eintragstyp (const Operator<F>&) aufgerufen werden kann
+            @param text: Der Text ab dem Rechenzeichen
+            @param besucher: Wird mit dem gefundenen Eintrag aufgerufen, nicht aber, wenn kein Rechenzeichen passt
+            @returns Die Länge des gefundenen Namens, 0 wenn kein Rechenzeichen passt
+         */
+        template <typename Besucher> constexpr std::size_t finde( std::string_view text, Besucher&& besucher ) const {
+            const auto [index, laenge] = suche( text, std::index_sequence_for<Operatoren ...>() );
+            if( laenge != 0 )
+                besuche( index, besucher, std::index_sequence_for<Operatoren ...>() );
+            return laenge;
+        }
+
+        /**
+            @brief Wendet das längste Rechenzeichen, mit dem text beginnt, auf zahlenstapel an.
+            @arg T: Datentyp der Zahlen
+            @param text: Der Text ab dem Rechenzeichen
+            @param zahlenstapel: Der Zahlenstapel
+            @returns Die Länge des angewandten Namens, 0 wenn kein Rechenzeichen passt
+            @throws std::runtime_error, wenn nicht genug Zahlen auf dem Stapel liegen
+         */
+        template <typename T> std::size_t wendeAn( std::string_view text, std::vector<T>& zahlenstapel ) const {
+            return finde( text, [&zahlenstapel]( const auto& eintrag ) {
+                berechneOperation( zahlenstapel, eintrag.operation, eintrag.name, eintrag.stellen );
+            } );
+        }
+
+    private:
+        template <std::size_t ... I> constexpr std::pair<std::size_t, std::size_t> suche( std::string_view text, std::index_sequence<I ...> ) const {
+            std::pair<std::size_t, std::size_t> bester( 0, 0 );
+            ///Das erste Zeichen wird zuerst verglichen, bei einzelnen Zeichen ist damit schon entschieden.
+            ( ( !text.empty() && text[0] == std::get<I>( operatoren ).name[0]
+                && std::get<I>( operatoren ).name.size() >= bester.second
+                && text.substr( 0, std::get<I>( operatoren ).name.size() ) == std::get<I>( operatoren ).name
+                && ( bester = { I, std::get<I>( operatoren ).name.size() }, true ) ), ... );
+            return bester;
+        }
+
+        template <typename Besucher, std::size_t ... I> constexpr void besuche( std::size_t index, Besucher& besucher, std::index_sequence<I ...> ) const {
+            ( void )( ( I == index && ( besucher( std::get<I>( operatoren ) ), true ) ) || ... );
+        }
+
+        std::tuple<Operatoren ...> operatoren;
+};
+
 ///Templates für Grundrechenarten
 /**
     @brief Addiert zwei Zahlen.
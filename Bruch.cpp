@@ -1,11 +1,3 @@
 #include "Bruch.h"
-
-//Der Algorithmus ist dem GdP Seminar Aufgabe 5.4 entnommen.
-unsigned long int ggt( const unsigned long int& a, const unsigned long int& b ) {
-    if( a < b )
-        return ggt( b, a );
-    else if( ( a % b ) == 0 )
-        return b;
-    else
-        return ggt( b, a % b );
-}
+//Der ggT war ursprünglich hier rekursiv nach dem GdP Seminar Aufgabe 5.4 umgesetzt. Er ist inzwischen ein Template und steht deshalb in Bruch.h.
+//Die Datei bleibt wie Berechner.cpp im Projekt, damit sich die Kompilierbefehle nicht ändern.
@@ -3,34 +3,224 @@
 
 #include <type_traits>
 #include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "Instrumentierung.h"
+
+/**
+        @brief Prüft, ob T ein eingebauter Ganzzahltyp ist.
+        Anders als std::is_integral werden auch __int128 und unsigned __int128 erkannt, die im strikten C++17-Modus nicht als integral gelten. bool zählt nicht als Ganzzahl.
+        @arg T: zu prüfender Datentyp
+ */
+template <typename T> struct IstEingebauteGanzzahl
+    : std::integral_constant < bool, ( std::is_integral<T>::value && !std::is_same<T, bool>::value )
+      || std::is_same<T, __int128>::value || std::is_same<T, unsigned __int128>::value > {};
+
+/**
+        @brief Liefert zu einem eingebauten Ganzzahltyp den vorzeichenlosen Typ gleicher Breite.
+        Wie std::make_unsigned, aber auch für __int128 im strikten C++17-Modus.
+        @arg T: eingebauter Ganzzahltyp
+ */
+template <typename T> struct VorzeichenloseForm {
+    using Typ = typename std::make_unsigned<T>::type;
+};
+template <> struct VorzeichenloseForm<__int128> {
+    using Typ = unsigned __int128;
+};
+template <> struct VorzeichenloseForm<unsigned __int128> {
+    using Typ = unsigned __int128;
+};
+
+/**
+        @brief Zählt die Nullbits am unteren Ende von x.
+        Die Funktion bildet die passende count-trailing-zeros Instruktion für die Breite von U ab. 128-Bit-Zahlen werden in zwei Hälften geprüft.
+        @arg U: vorzeichenloser eingebauter Ganzzahltyp
+        @param x: Die Zahl
+        @returns Anzahl der Nullbits unterhalb des niedrigsten gesetzten Bits
+        @pre x != 0
+ */
+template <typename U> constexpr int zaehleEndnullen( const U& x ) {
+    if constexpr( sizeof( U ) <= sizeof( unsigned int ) )
+        return __builtin_ctz( x );
+    else if constexpr( sizeof( U ) <= sizeof( unsigned long ) )
+        return __builtin_ctzl( x );
+    else if constexpr( sizeof( U ) <= sizeof( unsigned long long ) )
+        return __builtin_ctzll( x );
+    else {
+        const unsigned long long unten = static_cast<unsigned long long>( x );
+        if( unten != 0 )
+            return __builtin_ctzll( unten );
+        return 64 + __builtin_ctzll( static_cast<unsigned long long>( x >> 64 ) );
+    }
+}
 
 /**
         @brief Gibt größten gemeinsamen Teiler der Zahlen zurück.
-        Die Funktion bestimmt rekursiv den ggT der natürlichen Zahlen a und b.
+        Für eingebaute Ganzzahltypen bestimmt die Funktion den ggT iterativ mit dem binären Algorithmus von Stein, der statt Divisionen nur Verschiebungen und Subtraktionen braucht.
+        Für andere Ganzzahltypen (z.B. eine Langzahl) wird iterativ nach Euklid gerechnet, ohne den Wert auf einen kleineren Typ einzuschränken.
+        Gleitkommazahlen werden wie bisher auf ihren ganzzahligen Anteil (als unsigned long) reduziert.
+        @arg T: Datentyp der Zahlen
         @param a: Zahl a
         @param b: Zahl b
-        @returns Größten gemeinsamen Teiler
+        @returns Größten gemeinsamen Teiler, ggt( a, 0 ) = a
+        @pre a >= 0 und b >= 0
  */
-unsigned long int ggt( const unsigned long int& a, const unsigned long int& b );
+template <typename T> constexpr T ggt( const T& a, const T& b ) {
+    std::uint64_t schritte = 0;
+    if constexpr( instrumentiert && !std::is_floating_point<T>::value )
+        zaehle( Zaehler::GgtAufrufe );
+    if constexpr( IstEingebauteGanzzahl<T>::value ) {
+        using U = typename VorzeichenloseForm<T>::Typ;
+        U u = static_cast<U>( a );
+        U v = static_cast<U>( b );
+        if( u == 0 )
+            return b;
+        if( v == 0 )
+            return a;
+        ///Gemeinsame Zweierpotenz merken, danach bleibt u immer ungerade.
+        const int zweierpotenz = zaehleEndnullen<U>( u | v );
+        u >>= zaehleEndnullen<U>( u );
+        v >>= zaehleEndnullen<U>( v );
+        ///Die Differenz zweier ungerader Zahlen ist gerade, ihre Nullbits werden sofort wieder entfernt.
+        ///Minimum und Differenz werden ohne Sprung gebildet, damit die Schleife nicht an falschen Sprungvorhersagen hängt.
+        while( u != v ) {
+            const U kleiner = u < v ? u : v;
+            const U differenz = u < v ? v - u : u - v;
+            v = kleiner;
+            u = differenz >> zaehleEndnullen<U>( differenz );
+            schritte++;
+        }
+        if constexpr( instrumentiert )
+            zaehle( Zaehler::GgtSchritte, schritte );
+        return static_cast<T>( u << zweierpotenz );
+    } else if constexpr( std::is_floating_point<T>::value ) {
+        return static_cast<T>( ggt( static_cast<unsigned long int>( a ), static_cast<unsigned long int>( b ) ) );
+    } else {
+        T u = a;
+        T v = b;
+        while( v != 0 ) {
+            T rest = u % v;
+            u = v;
+            v = rest;
+            schritte++;
+        }
+        if constexpr( instrumentiert )
+            zaehle( Zaehler::GgtSchritte, schritte );
+        return u;
+    }
+}
+
+/**
+        @brief Gibt den Betrag der Zahl zurück.
+        @arg T: Datentyp der Zahl
+        @param x: Die Zahl
+        @returns |x|
+ */
+template <typename T> constexpr T betrag( const T& x ) {
+    if( x < 0 )
+        return static_cast<T>( -x );
+    return x;
+}
+
+/**
+        @brief Gibt die Anzahl der Bits zurück, die zur Darstellung von x nötig sind.
+        Für eingebaute Ganzzahltypen wird die count-leading-zeros Instruktion genutzt, andere Ganzzahltypen werden schrittweise halbiert.
+        Gleitkommazahlen haben keine sinnvolle Bitbreite, für sie wird 0 zurückgegeben.
+        @arg T: Datentyp der Zahl
+        @param x: Die Zahl
+        @returns Bitbreite von x, bitbreite( 0 ) = 0
+        @pre x >= 0
+ */
+template <typename T> constexpr int bitbreite( const T& x ) {
+    if constexpr( IstEingebauteGanzzahl<T>::value ) {
+        using U = typename VorzeichenloseForm<T>::Typ;
+        const U u = static_cast<U>( x );
+        if( u == 0 )
+            return 0;
+        if constexpr( sizeof( U ) <= sizeof( unsigned long long ) )
+            return 8 * sizeof( unsigned long long ) - __builtin_clzll( u );
+        else {
+            const unsigned long long oben = static_cast<unsigned long long>( u >> 64 );
+            if( oben != 0 )
+                return 128 - __builtin_clzll( oben );
+            return 64 - __builtin_clzll( static_cast<unsigned long long>( u ) );
+        }
+    } else if constexpr( std::is_floating_point<T>::value ) {
+        return 0;
+    } else {
+        int bits = 0;
+        for( T rest = x; rest != 0; rest /= 2 )
+            bits++;
+        return bits;
+    }
+}
+
+///Kürzungsstrategien
+///Eine Kürzungsstrategie legt fest, ob ein Bruch nach einer Rechenoperation gekürzt wird. Sie wird Bruch als zweiter Templateparameter übergeben.
+/**
+        @brief Kürzt nie selbstständig.
+        Der Bruch wird nur durch den Operator 'k' oder am Ende von berechneNaechstenTerm gekürzt (bisheriges Verhalten).
+ */
+struct KuerzeNie {
+    template <typename B> static constexpr void nachOperation( B& ) {
+    }
+};
+/**
+        @brief Kürzt nach jeder Rechenoperation.
+ */
+struct KuerzeImmer {
+    template <typename B> static constexpr void nachOperation( B& b ) {
+        b.kuerzeBruch();
+    }
+};
+/**
+        @brief Kürzt nur, wenn Zähler oder Nenner breiter als Bitbreite Bits geworden sind.
+        Die Strategie spart die ggT-Berechnung, solange die Zahlen klein sind, und verhindert trotzdem, dass sie unbegrenzt wachsen.
+        @arg Bitbreite: Schwelle in Bits, ab der gekürzt wird
+ */
+template <int Bitbreite> struct KuerzeAbBitbreite {
+    template <typename B> static constexpr void nachOperation( B& b ) {
+        if( bitbreite( betrag( b.getZaehler() ) ) > Bitbreite || bitbreite( betrag( b.getNenner() ) ) > Bitbreite )
+            b.kuerzeBruch();
+    }
+};
+
+/**
+        @brief Wird geworfen, wenn ein Bruch mit dem Nenner 0 entstehen würde, z.B. wenn das Produkt zweier Nenner überläuft und 0 ergibt.
+ */
+class NennerNull : public std::runtime_error {
+    public:
+        NennerNull()
+            : std::runtime_error( "Eine Division durch Null (bzw. eine Null im Nenner) ist nicht möglich." ) {
+        }
+};
 
 /**
         @brief Speichert eine rationale Zahl als Bruch.
         Die Zahl wird als Zähler und Nenner gespeichert, wobei beide Variabeln den Datentyp T haben.
+        Konstruktoren, kuerzeBruch() und die Rechenoperatoren sind constexpr, sodass Brüche eingebauter Zahlentypen schon beim Kompilieren berechnet werden können.
         @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie, die nach jeder Rechenoperation angewandt wird (KuerzeNie, KuerzeImmer oder KuerzeAbBitbreite)
  */
-template <typename T>
+template <typename T, typename K = KuerzeNie>
 class Bruch {
     public:
+        using Kuerzung = K;
+
         /**
             @brief Konstruktor: Initialisiert den Bruch.
-            Der Konstruktor initialisiert den Bruch mit zaehler/nenner. Falls der nenner = 0 ist, wird ein runtime-error geworfen, da eine Division durch 0 nicht erlaubt wird.
+            Der Konstruktor initialisiert den Bruch mit zaehler/nenner. Falls der nenner = 0 ist, wird NennerNull (ein runtime-error) geworfen, da eine Division durch 0 nicht erlaubt wird.
             @param n: Nenner des Bruchs
             @param z: Zähler des Bruchs
          */
-        Bruch( const T& n, const T& z )
+        constexpr Bruch( const T& n, const T& z )
             :  zaehler( z ), nenner( n ) {
             if( nenner == 0 )
-                throw std::runtime_error( "Eine Division durch Null (bzw. eine Null im Nenner) ist nicht möglich." );
+                throw NennerNull();
         }
 
         /**
@@ -38,7 +228,7 @@ class Bruch {
             Der Konstruktor initialisiert den Bruch mit zaehler/1. Falls kein Zähler übergeben wird, wird der Bruch mit 0/1 (= 0) inititalisiert.
             @param z: zaehler des Bruchs, default = 0
          */
-        Bruch( const T& z = 0 )
+        constexpr Bruch( const T& z = 0 )
             :  zaehler( z ), nenner( 1 ) {
         }
 
@@ -49,7 +239,7 @@ class Bruch {
             - werden beide Zahlen mit -1 multipliziert, falls beide Zahlen negativ sind.
             Ist der Bruch 0/x (mit x != 0) lässt er sich am simpelsten durch 0/1 darstellen. Ansonsten lässt er sich nicht sinnvoll kürzen.
          */
-        void kuerzeBruch() {
+        constexpr void kuerzeBruch() {
             if( zaehler == 0 )
                 nenner = 1;
             else {
@@ -59,8 +249,8 @@ class Bruch {
                 T betragNenner = nenner;
                 if( betragZaehler < 0 )
                     betragZaehler *= -1;
-                if( betragZaehler < 0 )
-                    betragZaehler *= -1;
+                if( betragNenner < 0 )
+                    betragNenner *= -1;
                 T ggTeiler = ggt( betragZaehler, betragNenner );
                 nenner /= ggTeiler;
                 zaehler /= ggTeiler;
@@ -77,7 +267,7 @@ class Bruch {
             @brief Gibt den Zähler des Bruchs zurück.
             @returns Zähler
          */
-        T getZaehler() const {
+        constexpr T getZaehler() const {
             return zaehler;
         }
 
@@ -86,7 +276,7 @@ class Bruch {
             @brief Gibt den Nenner des Bruchs zurück.
             @returns Nenner
          */
-        T getNenner() const {
+        constexpr T getNenner() const {
             return nenner;
         }
 
@@ -95,66 +285,121 @@ class Bruch {
         T nenner;
 };
 
+/**
+        @brief Trägt die Bitbreite von b in das Histogramm der Instrumentierung ein.
+        Gezählt wird die größere Bitbreite der Beträge von Zähler und Nenner.
+        @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie
+        @param b: Der Operand
+ */
+template <typename T, typename K> void erfasseBitbreite( const Bruch<T, K>& b ) {
+    erfasseBitbreite( std::max( bitbreite( betrag( b.getZaehler() ) ), bitbreite( betrag( b.getNenner() ) ) ) );
+}
+
 /**
         @brief Gibt Kehrwert des Bruchs zurück.
         Die Funktion erzeugt einen Neuen Bruch mit dem Zähler von b als Nenner und dem Nenner von b als Zähler.
         @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie
         @param b: ursprünglicher Bruch
         @returns Kehrwert des Bruchs
  */
-template <typename T> Bruch<T> kehrwert( const Bruch<T>& b ) {
-    return Bruch<T>( b.getZaehler(), b.getNenner() );
+template <typename T, typename K> constexpr Bruch<T, K> kehrwert( const Bruch<T, K>& b ) {
+    return Bruch<T, K>( b.getZaehler(), b.getNenner() );
 }
 
 /**
         @brief Gibt den gekürzten Bruch zurück.
         @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie
         @param b: ursprünglicher Bruch
         @returns Den gekürzten Bruch
  */
-template <typename T> Bruch<T> kuerzeBruch( const Bruch<T>& b ) {
+template <typename T, typename K = KuerzeNie> constexpr Bruch<T, K> kuerzeBruch( const Bruch<T, K>& b ) {
     //Den Parameter als Referenz zu nehmen und dann 'manuell' zu kopieren ist nötig, damit b eine const Referenz sein kann
     //und die Parameter der Operation damit zu den Anforderungen von berechneOperation passt.
-    Bruch<T> a = b;
+    Bruch<T, K> a = b;
     a.kuerzeBruch();
     return a;
 }
 
 ///Addition
+/**
+        @brief Addiert oder subtrahiert zwei Brüche, gemeinsame Umsetzung der Operatoren + und -.
+        Bei gleichen Nennern werden nur die Zähler addiert, der Nenner bleibt, wie er ist.
+        Sind die Nenner zusammen breiter als 128 Bit, wird sonst nach Henrici (Knuth, TAOCP Bd. 2, 4.5.1) über das kgV der Nenner addiert: Mit d = ggT(nennerA, nennerB) ist die Summe
+        (zaehlerA * nennerB/d ± zaehlerB * nennerA/d) / (nennerA/d * nennerB). Teilt ein Nenner den anderen, wächst der Nenner also nicht.
+        Bei schmaleren Nennern (und damit immer bei eingebauten Ganzzahlen) kostet der ggT mehr, als die kleineren Zahlen beim Multiplizieren und Kürzen sparen,
+        dort wird wie bisher über das Produkt der Nenner addiert. Auch die einfachere Prüfung, ob der kleinere Nenner den größeren teilt, lohnt sich dort nicht:
+        Mit long int kostet die eine Division mehr als das Produkt, selbst wenn der kleinere Nenner den größeren teilt (gemessen mit nenner/long/.../teiler und zweierpotenzen:
+        ohne Kürzen etwa 2 ns über das Produkt gegen 4,5 ns mit der Prüfung, mit KuerzeImmer 44 gegen 50 bzw. 50 gegen 56 ns).
+        @arg Subtraktion: True, wenn summandB abgezogen wird
+        @returns Die Summe bzw. Differenz
+ */
+template <bool Subtraktion, typename A, typename B, typename K> constexpr auto addiereBrueche( const Bruch<A, K>& summandA, const Bruch<B, K>& summandB ) {
+    using Z = decltype( summandA.getZaehler() * summandB.getNenner() );
+    Z zaehlerA = summandA.getZaehler();
+    Z nennerA = summandA.getNenner();
+    Z zaehlerB = summandB.getZaehler();
+    Z nennerB = summandB.getNenner();
+    if constexpr( Subtraktion )
+        zaehlerB = zaehlerB * -1;
+    if constexpr( !std::is_floating_point<Z>::value ) {
+        if( nennerA == nennerB ) {
+            Bruch<Z, K> summe( nennerA, zaehlerA + zaehlerB );
+            K::nachOperation( summe );
+            return summe;
+        }
+        if constexpr( !IstEingebauteGanzzahl<Z>::value ) {
+            const Z teiler = bitbreite( nennerA ) + bitbreite( nennerB ) > 128 ? ggt( betrag( nennerA ), betrag( nennerB ) ) : Z( 1 );
+            if( teiler != 1 ) {
+                nennerA /= teiler;
+                Bruch<Z, K> summe( nennerA * nennerB, zaehlerA * ( nennerB / teiler ) + zaehlerB * nennerA );
+                K::nachOperation( summe );
+                return summe;
+            }
+        }
+    }
+    Bruch<Z, K> summe( nennerA * nennerB, zaehlerA * nennerB + zaehlerB * nennerA );
+    K::nachOperation( summe );
+    return summe;
+}
+
 /**
         @brief Addiert die Brüche.
         @arg A: Speicherklasse von Zähler und Nenner von SummandA
         @arg B: Speicherklasse von Zähler und Nenner von SummandB
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param summandA: der erste Summand
         @param summandB: der zweite Summand
         @returns Die Summe
  */
-template <typename A, typename B> auto operator + ( const Bruch<A>& summandA, const Bruch<B>& summandB ) {
-    auto zaehler = ( summandA.getZaehler() * summandB.getNenner() ) + ( summandB.getZaehler() * summandA.getNenner() );
-    auto nenner = summandA.getNenner() * summandB.getNenner();
-    return Bruch( nenner, zaehler );
+template <typename A, typename B, typename K> constexpr auto operator + ( const Bruch<A, K>& summandA, const Bruch<B, K>& summandB ) {
+    return addiereBrueche<false>( summandA, summandB );
 }
 /**
         @brief Addiert einen Bruch mit einer Zahl.
         @arg A: Speicherklasse von Zähler und Nenner von SummandA
         @arg B: Typ vom zweiten Summand
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param summandA: der erste Summand
         @param summandB: der zweite Summand
         @returns Die Summe
  */
-template <typename A, typename B> auto operator + ( const Bruch<A>& summandA, const B& summandB ) {
-    return summandA + Bruch<B>( summandB );
+template <typename A, typename B, typename K> constexpr auto operator + ( const Bruch<A, K>& summandA, const B& summandB ) {
+    return summandA + Bruch<B, K>( summandB );
 }
 /**
         @brief Addiert einen Bruch mit einer Zahl.
         @arg A: Typ vom ersten Summand
         @arg B: Speicherklasse von Zähler und Nenner von SummandB
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param summandA: der erste Summand
         @param summandB: der zweite Summand
         @returns Die Summe
  */
-template <typename A, typename B> auto operator + ( const A& summandA, const Bruch<B>& summandB ) {
-    return Bruch<A>( summandA ) + summandB;
+template <typename A, typename B, typename K> constexpr auto operator + ( const A& summandA, const Bruch<B, K>& summandB ) {
+    return Bruch<A, K>( summandA ) + summandB;
 }
 
 ///Subtraktion
@@ -162,105 +407,388 @@ template <typename A, typename B> auto operator + ( const A& summandA, const Bru
         @brief Sutrahiert die Brüche.
         @arg A: Speicherklasse von Zähler und Nenner von minuend
         @arg B: Speicherklasse von Zähler und Nenner von subtrahend
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param minuend: der Minuend
         @param subtrahend: der Subtrahend
         @returns Die Differenz
  */
-template <typename A, typename B> auto operator - ( const Bruch<A>& minuend, const Bruch<B>& subtrahend ) {
-    return minuend + ( subtrahend * -1 );
+template <typename A, typename B, typename K> constexpr auto operator - ( const Bruch<A, K>& minuend, const Bruch<B, K>& subtrahend ) {
+    return addiereBrueche<true>( minuend, subtrahend );
 }
 /**
         @brief Sutrahiert die Brüche.
         @arg A: Speicherklasse von Zähler und Nenner von minuend
         @arg B: Typ vom subtrahend
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param minuend: der Minuend
         @param subtrahend: der Subtrahend
         @returns Die Differenz
  */
-template <typename A, typename B> auto operator - ( const Bruch<A>& minuend, const B& subtrahend ) {
-    return minuend - Bruch<B>( subtrahend );
+template <typename A, typename B, typename K> constexpr auto operator - ( const Bruch<A, K>& minuend, const B& subtrahend ) {
+    return minuend - Bruch<B, K>( subtrahend );
 }
 /**
         @brief Sutrahiert die Brüche.
         @arg A: Typ vom minuend
         @arg B: Speicherklasse von Zähler und Nenner von subtrahend
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param minuend: der Minuend
         @param subtrahend: der Subtrahend
         @returns Die Differenz
  */
-template <typename A, typename B> auto operator - ( const A& minuend, const Bruch<B>& subtrahend ) {
-    return Bruch<A>( minuend ) - subtrahend;
+template <typename A, typename B, typename K> constexpr auto operator - ( const A& minuend, const Bruch<B, K>& subtrahend ) {
+    return Bruch<A, K>( minuend ) - subtrahend;
 }
 
 ///Multiplikation
 /**
         @brief Multipliziert die Brüche.
+        Für Ganzzahltypen mit Vorzeichen wird vorher über Kreuz gekürzt, das Produkt gekürzter Faktoren ist dann selbst gekürzt.
+        Für vorzeichenlose Typen und Gleitkommazahlen wird nicht über Kreuz gekürzt, dort ist das Produkt gekürzter Faktoren im Allgemeinen nicht gekürzt.
+        Das gilt ebenso für die Division.
         @arg A: Speicherklasse von Zähler und Nenner von faktorA
         @arg B: Speicherklasse von Zähler und Nenner von faktorB
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param faktorA: der erste Faktor
         @param faktorB: der zweite Faktor
         @returns Das Produkt
  */
-template <typename A, typename B> auto operator * ( const Bruch<A>& faktorA, const Bruch<B>& faktorB ) {
-    return Bruch( faktorA.getNenner() * faktorB.getNenner(), faktorA.getZaehler() * faktorB.getZaehler() );
+template <typename A, typename B, typename K> constexpr auto operator * ( const Bruch<A, K>& faktorA, const Bruch<B, K>& faktorB ) {
+    using Z = decltype( faktorA.getZaehler() * faktorB.getZaehler() );
+    Z zaehlerA = faktorA.getZaehler();
+    Z nennerA = faktorA.getNenner();
+    Z zaehlerB = faktorB.getZaehler();
+    Z nennerB = faktorB.getNenner();
+    ///Über Kreuz kürzen (Knuth, TAOCP Bd. 2, 4.5.1): Vor dem Multiplizieren werden zaehlerA und nennerB sowie zaehlerB und nennerA durch ihren ggT geteilt.
+    ///So bleiben die Zwischenergebnisse klein und das Produkt ist bereits gekürzt, wenn es beide Faktoren waren.
+    ///Vorzeichenlose Typen rechnen negative Zähler modulo 2^n, dort verträgt sich das Teilen nicht mit dem Überlauf (-1 wird zu 2^64 - 1, das durch 3 teilbar ist).
+    if constexpr( !std::is_floating_point<Z>::value && !std::is_unsigned<Z>::value ) {
+        const Z teilerA = ggt( betrag( zaehlerA ), betrag( nennerB ) );
+        if( teilerA != 1 ) {
+            zaehlerA /= teilerA;
+            nennerB /= teilerA;
+        }
+        const Z teilerB = ggt( betrag( zaehlerB ), betrag( nennerA ) );
+        if( teilerB != 1 ) {
+            zaehlerB /= teilerB;
+            nennerA /= teilerB;
+        }
+    }
+    Bruch<Z, K> produkt( nennerA * nennerB, zaehlerA * zaehlerB );
+    K::nachOperation( produkt );
+    return produkt;
 }
 /**
         @brief Multipliziert die Brüche.
         @arg A: Speicherklasse von Zähler und Nenner von faktorA
         @arg B: Typ von faktorB
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param faktorA: der erste Faktor
         @param faktorB: der zweite Faktor
         @returns Das Produkt
  */
-template <typename A, typename B> auto operator * ( const Bruch<A>& faktorA, const B& faktorB ) {
-    return faktorA * Bruch<B>( faktorB );
+template <typename A, typename B, typename K> constexpr auto operator * ( const Bruch<A, K>& faktorA, const B& faktorB ) {
+    return faktorA * Bruch<B, K>( faktorB );
 }
 /**
         @brief Multipliziert die Brüche.
         @arg A: Typ von faktorA
         @arg B: Speicherklasse von Zähler und Nenner von faktorB
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param faktorA: der erste Faktor
         @param faktorB: der zweite Faktor
         @returns Das Produkt
  */
-template <typename A, typename B> auto operator * ( const A& faktorA, const Bruch<B>& faktorB ) {
-    return Bruch<A>( faktorA ) * faktorB;
+template <typename A, typename B, typename K> constexpr auto operator * ( const A& faktorA, const Bruch<B, K>& faktorB ) {
+    return Bruch<A, K>( faktorA ) * faktorB;
 }
 
 ///Division
 /**
         @brief Dividiert die Brüche.
+        Die Division multipliziert mit dem Kehrwert und kürzt dadurch wie der Operator * über Kreuz, also nicht für vorzeichenlose Typen und Gleitkommazahlen.
         @arg A: Speicherklasse von Zähler und Nenner von divident
         @arg B: Speicherklasse von Zähler und Nenner von divisor
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param divident: der Divident
         @param divisor: der Divisor
         @returns Der Quotient
  */
-template <typename A, typename B> auto operator / ( const Bruch<A>& divident, const Bruch<B>& divisor ) {
+template <typename A, typename B, typename K> constexpr auto operator / ( const Bruch<A, K>& divident, const Bruch<B, K>& divisor ) {
     return divident * kehrwert( divisor );
 }
 /**
         @brief Dividiert die Brüche.
         @arg A: Speicherklasse von Zähler und Nenner von divident
         @arg B: Typ von divisor
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param divident: der Divident
         @param divisor: der Divisor
         @returns Der Quotient
  */
-template <typename A, typename B> auto operator / ( const Bruch<A>& divident, const B& divisor ) {
-    return divident / Bruch<B>( divisor );
+template <typename A, typename B, typename K> constexpr auto operator / ( const Bruch<A, K>& divident, const B& divisor ) {
+    return divident / Bruch<B, K>( divisor );
 }
 /**
         @brief Dividiert die Brüche.
         @arg A: Typ von divident
         @arg B: Speicherklasse von Zähler und Nenner von divisor
+        @arg K: Kürzungsstrategie des Ergebnisses
         @param divident: der Divident
         @param divisor: der Divisor
         @returns Der Quotient
  */
-template <typename A, typename B> auto operator / ( const A& divident, const Bruch<B>& divisor ) {
-    return Bruch<A>( divident ) / divisor;
+template <typename A, typename B, typename K> constexpr auto operator / ( const A& divident, const Bruch<B, K>& divisor ) {
+    return Bruch<A, K>( divident ) / divisor;
+}
+
+///Vergleiche
+/**
+        @brief Vergleicht die Werte zweier positiver Brüche za/na und zb/nb ohne Multiplikation.
+        Die ganzzahligen Anteile werden verglichen, bei Gleichheit die Kehrwerte der Reste (Kettenbruchentwicklung). Es entstehen nur Zahlen, die nicht größer als die Eingaben sind,
+        der Vergleich läuft also für jeden Ganzzahltyp ohne Überlauf.
+        @returns -1, 0 oder 1, wenn za/na kleiner, gleich oder größer als zb/nb ist
+        @pre za >= 0, zb >= 0, na > 0, nb > 0
+ */
+template <typename T> constexpr int vergleicheKettenbruch( T za, T na, T zb, T nb ) {
+    int richtung = 1;
+    for( ;; ) {
+        const T ganzA = za / na;
+        const T ganzB = zb / nb;
+        if( ganzA != ganzB )
+            return ganzA < ganzB ? -richtung : richtung;
+        za -= ganzA * na;
+        zb -= ganzB * nb;
+        if( za == 0 || zb == 0 )
+            return za == zb ? 0 : ( za == 0 ? -richtung : richtung );
+        ///za/na < zb/nb genau dann, wenn na/za > nb/zb.
+        const T restA = za, restB = zb;
+        za = na;
+        na = restA;
+        zb = nb;
+        nb = restB;
+        richtung = -richtung;
+    }
+}
+
+/**
+        @brief Vergleicht die Werte zweier Brüche exakt.
+        Verglichen wird über Kreuz, zaehlerA * nennerB mit zaehlerB * nennerA, das Ergebnis wird bei Nennern mit verschiedenem Vorzeichen umgedreht.
+        Für eingebaute Ganzzahlen bis 64 Bit werden die Produkte in 128 Bit gebildet und können nicht überlaufen. Für __int128 wird ohne Multiplikation mit vergleicheKettenbruch verglichen.
+        Andere Typen (z.B. eine Langzahl) multiplizieren direkt. Für Geprueft gibt es eine Überladung in Geprueft.h, die die entpackten Werte vergleicht.
+        Brüche mit gleichem Wert sind gleich, auch wenn sie nicht gekürzt sind (1/2 und 2/4).
+        @arg A: Speicherklasse von Zähler und Nenner von a
+        @arg B: Speicherklasse von Zähler und Nenner von b
+        @arg K: Kürzungsstrategie
+        @returns -1, 0 oder 1, wenn a kleiner, gleich oder größer als b ist
+ */
+template <typename A, typename B, typename K> constexpr int vergleiche( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    if constexpr( IstEingebauteGanzzahl<A>::value && IstEingebauteGanzzahl<B>::value && sizeof( A ) <= 8 && sizeof( B ) <= 8 ) {
+        if constexpr( std::is_unsigned<A>::value && std::is_unsigned<B>::value ) {
+            const unsigned __int128 links = static_cast<unsigned __int128>( a.getZaehler() ) * b.getNenner();
+            const unsigned __int128 rechts = static_cast<unsigned __int128>( b.getZaehler() ) * a.getNenner();
+            return ( links > rechts ) - ( links < rechts );
+        } else {
+            const __int128 links = static_cast<__int128>( a.getZaehler() ) * static_cast<__int128>( b.getNenner() );
+            const __int128 rechts = static_cast<__int128>( b.getZaehler() ) * static_cast<__int128>( a.getNenner() );
+            const int ergebnis = ( links > rechts ) - ( links < rechts );
+            return ( a.getNenner() < 0 ) != ( b.getNenner() < 0 ) ? -ergebnis : ergebnis;
+        }
+    } else if constexpr( IstEingebauteGanzzahl<A>::value && std::is_same<A, B>::value ) {
+        ///Vorzeichen in den Zähler bringen, dann zuerst nach Vorzeichen vergleichen.
+        A za = a.getZaehler(), na = a.getNenner(), zb = b.getZaehler(), nb = b.getNenner();
+        if( na < 0 ) {
+            za = -za;
+            na = -na;
+        }
+        if( nb < 0 ) {
+            zb = -zb;
+            nb = -nb;
+        }
+        if( ( za < 0 ) != ( zb < 0 ) )
+            return za < 0 ? -1 : 1;
+        if( za < 0 )
+            return vergleicheKettenbruch<A>( -zb, nb, -za, na );
+        return vergleicheKettenbruch<A>( za, na, zb, nb );
+    } else {
+        const auto links = a.getZaehler() * b.getNenner();
+        const auto rechts = b.getZaehler() * a.getNenner();
+        const int ergebnis = ( links > rechts ) - ( links < rechts );
+        return ( a.getNenner() < 0 ) != ( b.getNenner() < 0 ) ? -ergebnis : ergebnis;
+    }
+}
+
+/**
+        @brief Vergleichsoperatoren, alle über vergleiche. Sie vergleichen Werte, nicht die Darstellung: 1/2 == 2/4.
+ */
+template <typename A, typename B, typename K> constexpr bool operator == ( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    return vergleiche( a, b ) == 0;
+}
+template <typename A, typename B, typename K> constexpr bool operator != ( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    return vergleiche( a, b ) != 0;
+}
+template <typename A, typename B, typename K> constexpr bool operator < ( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    return vergleiche( a, b ) < 0;
+}
+template <typename A, typename B, typename K> constexpr bool operator > ( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    return vergleiche( a, b ) > 0;
+}
+template <typename A, typename B, typename K> constexpr bool operator <= ( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    return vergleiche( a, b ) <= 0;
+}
+template <typename A, typename B, typename K> constexpr bool operator >= ( const Bruch<A, K>& a, const Bruch<B, K>& b ) {
+    return vergleiche( a, b ) >= 0;
+}
+
+///n-stellige Summe und n-stelliges Produkt
+/**
+        @brief Summiert anzahl Brüche in einem Schritt.
+        Statt die Nenner wie beim Operator + paarweise zu multiplizieren, wird über das kleinste gemeinsame Vielfache der bisherigen Nenner summiert.
+        Jeder Summand kostet so einen ggT und drei Multiplikationen, und der Nenner der Zwischensumme bleibt das kgV statt des Produkts aller Nenner.
+        Die Kürzungsstrategie wird erst auf die fertige Summe angewandt. Gleitkommazahlen werden wie mit dem Operator + summiert.
+        @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie des Ergebnisses
+        @param brueche: Die Summanden
+        @param anzahl: Anzahl der Summanden
+        @returns Die Summe, 0 für anzahl = 0
+ */
+template <typename T, typename K> constexpr Bruch<T, K> summiere( const Bruch<T, K>* brueche, std::size_t anzahl ) {
+    T zaehler = 0;
+    T nenner = 1;
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        T z = brueche[i].getZaehler();
+        T n = brueche[i].getNenner();
+        if constexpr( std::is_floating_point<T>::value ) {
+            zaehler = zaehler * n + z * nenner;
+            nenner = nenner * n;
+        } else {
+            ///Das kgV wird mit positiven Nennern gebildet.
+            if( n < 0 ) {
+                n = -n;
+                z = -z;
+            }
+            const T teiler = ggt( nenner, n );
+            const T erweiterung = n / teiler;
+            zaehler = zaehler * erweiterung + z * ( nenner / teiler );
+            nenner = nenner * erweiterung;
+        }
+    }
+    Bruch<T, K> summe( nenner, zaehler );
+    K::nachOperation( summe );
+    return summe;
+}
+
+/**
+        @brief Multipliziert anzahl Brüche in einem Schritt.
+        Jeder Faktor wird mit dem Operator * an das bisherige Produkt multipliziert, sodass das Zwischenprodukt gekürzt bleibt, wenn es die Faktoren sind.
+        Wo der Operator * nicht über Kreuz kürzt (vorzeichenlose Typen), wird stattdessen jedes Zwischenprodukt gekürzt.
+        Die Kürzungsstrategie wird erst auf das fertige Produkt angewandt.
+        @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie des Ergebnisses
+        @param brueche: Die Faktoren
+        @param anzahl: Anzahl der Faktoren
+        @returns Das Produkt, 1 für anzahl = 0
+ */
+template <typename T, typename K> constexpr Bruch<T, K> multipliziere( const Bruch<T, K>* brueche, std::size_t anzahl ) {
+    Bruch<T, KuerzeNie> produkt( 1 );
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        produkt = produkt * Bruch<T, KuerzeNie>( brueche[i].getNenner(), brueche[i].getZaehler() );
+        if constexpr( std::is_unsigned<T>::value )
+            produkt.kuerzeBruch();
+    }
+    Bruch<T, K> ergebnis( produkt.getNenner(), produkt.getZaehler() );
+    K::nachOperation( ergebnis );
+    return ergebnis;
+}
+
+/**
+        @brief Liest die Anzahl der Operanden eines n-stelligen Rechenzeichens aus b.
+        @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie
+        @param b: Der Bruch mit der Anzahl
+        @param maximum: Die größte zulässige Anzahl, meist die Zahl der übrigen Brüche auf dem Stapel
+        @param anzahl: Die gelesene Anzahl, maximum + 1, wenn b größer als maximum ist
+        @returns False, wenn b keine nicht negative ganze Zahl ist
+ */
+template <typename T, typename K> constexpr bool leseAnzahl( const Bruch<T, K>& b, std::size_t maximum, std::size_t& anzahl ) {
+    Bruch<T, K> gekuerzt = b;
+    gekuerzt.kuerzeBruch();
+    const T zahl = gekuerzt.getZaehler();
+    if( gekuerzt.getNenner() != 1 || zahl < 0 )
+        return false;
+    if( T( maximum ) < zahl ) {
+        anzahl = maximum + 1;
+        return true;
+    }
+    ///Eingebaute Typen lassen sich umwandeln, für andere (z.B. Langzahl) wird bis zur Zahl gezählt, was höchstens maximum Schritte braucht.
+    if constexpr( IstEingebauteGanzzahl<T>::value || std::is_floating_point<T>::value )
+        anzahl = static_cast<std::size_t>( zahl );
+    else
+        for( anzahl = 0; T( anzahl ) < zahl; anzahl++ );
+    return T( anzahl ) == zahl;
 }
 
+/**
+        @brief Zählt das Rechenzeichen name und erfasst die Bitbreite seiner Operanden für die Instrumentierung.
+        Die Operanden von "N Σ" und "N Π" sind die N Zahlen unter der Anzahl, sonst die obersten stellen Zahlen.
+        @arg T: Speicherklasse von Zähler und Nenner
+        @arg K: Kürzungsstrategie
+        @param name: Der Name des Rechenzeichens, eigene Rechenzeichen werden nicht gezählt (siehe getZaehler)
+        @param stapel: Der Zahlenstapel vor dem Rechenzeichen
+        @param hoehe: Die Anzahl der Zahlen auf dem Stapel
+        @param stellen: Die Stellenzahl fester Rechenzeichen. Liegen nicht genug Zahlen auf dem Stapel, wird nichts erfasst.
+ */
+template <typename T, typename K> void erfasseRechenzeichen( std::string_view name, const Bruch<T, K>* stapel, std::size_t hoehe, std::size_t stellen ) {
+    const Zaehler z = getZaehler( name );
+    if( z == Zaehler::Anzahl )
+        return;
+    if( z == Zaehler::Summe || z == Zaehler::Produkt ) {
+        if( hoehe < 1 || !leseAnzahl( stapel[hoehe - 1], hoehe - 1, stellen ) || stellen > hoehe - 1 )
+            return;
+        hoehe--;
+    }
+    if( hoehe < stellen )
+        return;
+    zaehle( z );
+    for( std::size_t i = hoehe - stellen; i < hoehe; i++ )
+        erfasseBitbreite( stapel[i] );
+}
+
+///Hashwerte
+/**
+        @brief Gibt einen Hashwert der Zahl zurück.
+        Eingebaute Ganzzahlen bis 128 Bit werden auf 64 Bit gefaltet, andere Typen nutzen std::hash. Typen ohne std::hash (z.B. die Langzahl) stellen eine eigene Überladung bereit.
+        @arg T: Datentyp der Zahl
+ */
+template <typename T> std::size_t hashwert( const T& x ) {
+    if constexpr( IstEingebauteGanzzahl<T>::value ) {
+        const auto u = static_cast<typename VorzeichenloseForm<T>::Typ>( x );
+        if constexpr( sizeof( u ) > sizeof( std::uint64_t ) )
+            return static_cast<std::size_t>( static_cast<std::uint64_t>( u ) ^ ( static_cast<std::uint64_t>( u >> 64 ) * 0x9e3779b97f4a7c15ull ) );
+        else
+            return static_cast<std::size_t>( u );
+    } else
+        return std::hash<T>()( x );
+}
+
+/**
+        @brief Hashwert eines Bruchs, passend zu operator ==.
+        Gehasht wird die gekürzte Form mit positivem Nenner, 1/2, 2/4 und -1/-2 haben also denselben Hashwert. Dafür wird pro Aufruf einmal gekürzt.
+        Nur für Ganzzahltypen: Gleitkommabrüche haben keine eindeutige gekürzte Form (1/2 und 0.5/1 sind gleich, bleiben beim Kürzen aber verschieden).
+ */
+namespace std {
+    template <typename T, typename K> struct hash<Bruch<T, K>> {
+        static_assert( !std::is_floating_point<T>::value, "Brüche aus Gleitkommazahlen haben keine eindeutige gekürzte Form und können nicht passend zu operator == gehasht werden." );
+        std::size_t operator()( const Bruch<T, K>& b ) const {
+            Bruch<T, K> gekuerzt = b;
+            gekuerzt.kuerzeBruch();
+            ///Die Hashwerte eingebauter Zahlen sind die Zahlen selbst. Die Mischung verteilt auch kleine Zähler und Nenner über alle Bits.
+            std::uint64_t h = static_cast<std::uint64_t>( hashwert( gekuerzt.getZaehler() ) ) * 0x9e3779b97f4a7c15ull;
+            h ^= static_cast<std::uint64_t>( hashwert( gekuerzt.getNenner() ) ) + ( h >> 29 );
+            h *= 0xbf58476d1ce4e5b9ull;
+            return static_cast<std::size_t>( h ^ ( h >> 32 ) );
+        }
+    };
+}
 
 #endif // BRUCH_H
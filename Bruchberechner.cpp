@@ -1,5 +1,7 @@
 #include "Bruchberechner.h"
 
+#include <cctype>
+
 bool naechsteIstZahl( std::istream& is ) {
     char c;
     if( is.get( c ) ) {
@@ -25,6 +27,20 @@ bool naechsteIstZahl( std::istream& is ) {
         return false;
 }
 
+void leseRechenzeichen( std::istream& is, std::string& zeichen ) {
+    zeichen.clear();
+    char c;
+    if( !is.get( c ) )
+        return;
+    zeichen += c;
+    ///Meist folgt direkt ein Leerzeichen, dann bleibt es bei einem Aufruf von peek. Ein Minus vor einer Ziffer gehört schon zur nächsten Zahl.
+    for( int n = is.peek(); n != std::char_traits<char>::eof() && !std::isspace( n ) && !( n >= '0' && n <= '9' ); n = is.peek() ) {
+        if( n == '-' && naechsteIstZahl( is ) )
+            break;
+        zeichen += static_cast<char>( is.get() );
+    }
+}
+
 bool clearWhitespacesCharFound( std::istream& is ) {
     char c;
     if( is >> c ) {
@@ -33,3 +49,10 @@ bool clearWhitespacesCharFound( std::istream& is ) {
     } else
         return false;
 }
+
+std::ostream& operator << ( std::ostream& os, const GeprueftesErgebnis& ergebnis ) {
+    std::visit( [&os]( const auto & b ) {
+        os << b;
+    }, ergebnis );
+    return os;
+}
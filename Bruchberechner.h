@@ -5,9 +5,18 @@
 #include <vector>
 #include <stdexcept>
 #include <string>
+#include <sstream>
+#include <variant>
+#include <string_view>
 
 #include "Bruch.h"
+#include "Instrumentierung.h"
 #include "Berechner.h"
+#include "Geprueft.h"
+#include "Langzahl.h"
+#include "Termzerleger.h"
+#include "Termrechner.h"
+#include "Bruchoperatoren.h"
 
 /**
     @brief Testet, ob die nächste Zeichenkette eine Zahl ist.
@@ -30,11 +39,12 @@ bool clearWhitespacesCharFound( std::istream& );
     @brief Gibt einen Bruch aus.
     Der Operator gibt den Bruch b über den Ausgabestrom os aus. Wenn möglich, wird der Bruch als Ganzzahl ausgegeben.
     @arg T: Speicherdatentyp von Zähler und Nenner von b
+    @arg K: Kürzungsstrategie von b
     @param os: Der Ausgabestrom
     @param b: Der auszugebende Bruch
     @returns Den zusammengefügten Ausgabestrom
  */
-template <typename T> std::ostream& operator << ( std::ostream& os, const Bruch<T>& b ) {
+template <typename T, typename K> std::ostream& operator << ( std::ostream& os, const Bruch<T, K>& b ) {
     os << b.getZaehler();
     ///Sollte der Nenner 1 sein, ist seine Ausgabe überflüssig. Der Bruch wird dann als Ganzzahl ausgegeben.
     if( b.getNenner() != 1 )
@@ -48,11 +58,13 @@ template <typename T> std::ostream& operator << ( std::ostream& os, const Bruch<
     Dabei werden alle whitespace chars vor dem Bruch aus is gelöscht.
     Sollte direkt nach dem Nenner kein Bruchstrich ("/") kommen, wird die Zahl als Ganzzahl interpretiert und 1 in den Nenner geschrieben.
     @arg T: Datentyp von Zähler und Nenner des Bruchs
+    @arg K: Kürzungsstrategie des Bruchs
     @param is: Eingabestrom aus dem der Bruch gelesen wird
     @param b: Bruch, in den Zähler und Nenner geschrieben werden
+    Fehler werden direkt als Exception gemeldet. Das Einlesen über std::istream liegt bewusst außerhalb der Fehlercodes, ohne Exceptions liest Termzerleger::leseBruchOhneAusnahme.
     @pre Die Nächste Zeichenkette ist ein Bruch mit dem Format "[Zähler]/[Nenner]" oder "[Zähler]"
  */
-template <typename T> void operator >> ( std::istream& is, Bruch<T>& b ) {
+template <typename T, typename K> void operator >> ( std::istream& is, Bruch<T, K>& b ) {
     if( !clearWhitespacesCharFound( is ) )
         throw std::logic_error( "Der gegebene Inputstream ist leer." );
     if( !naechsteIstZahl( is ) )
@@ -70,74 +82,348 @@ template <typename T> void operator >> ( std::istream& is, Bruch<T>& b ) {
                 throw std::runtime_error( "Der Ausdruck besitzt direkt nach einem Bruchstrich keine Zahl, obwohl ein Nenner erwartet wird." );
             T nenner;
             is >> nenner;
-            b = Bruch<T>( nenner, zaehler );
+            b = Bruch<T, K>( nenner, zaehler );
         } else {
             is.putback( c );
-            b = Bruch<T>( zaehler );
+            b = Bruch<T, K>( zaehler );
         }
     } else
-        b = Bruch<T>( zaehler );
+        b = Bruch<T, K>( zaehler );
 }
 
 /**
-    @brief Berechnet das Ergebnis von term.
+    @brief Liest die nächsten Rechenzeichen aus is.
+    Gelesen wird bis zum nächsten whitespace char, zum Beginn einer Zahl oder zum Ende des Eingabestroms. Die gelesene Zeichenkette kann mehrere Rechenzeichen hintereinander enthalten (z.B. "++").
+    @param is: Der Eingabestrom
+    @param zeichen: Die Zeichenkette, in die gelesen wird, sie wird vorher geleert
+    @pre Das nächste Zeichen in is ist kein whitespace char und keine Zahl
+ */
+void leseRechenzeichen( std::istream& is, std::string& zeichen );
+
+/**
+    @brief Berechnet das Ergebnis von term mit den Rechenzeichen aus tabelle.
     Die Funktion liest den Term aus dem Eingangsstrom term und berechnet das Ergebnis.
     Die Zahlen des Terms werden als Brüche interpretiert. Der Term muss in Postfixnotation übergeben werden.
+    Folgen mehrere Rechenzeichen ohne Leerzeichen aufeinander, wird jeweils das längste passende Rechenzeichen der Tabelle gewählt.
     Das Endergebnis wird vollständig gekürzt zurückgegeben.
+    Der Weg über std::istream liegt bewusst außerhalb der Fehlercodes (siehe Termergebnis): Die Zahlen werden mit dem operator >> von T gelesen und Fehler direkt als Exception gemeldet.
+    Er ist keine Hülle um den Termrechner, eine Variante ohne Exceptions gibt es nur für std::string_view (berechneNaechstenTermOhneAusnahme).
     @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse (KuerzeNie, KuerzeImmer oder KuerzeAbBitbreite)
+    @arg Tabelle: Typ der Operatortabelle
     @param term: der zu berechnende Term
+    @param tabelle: Die Rechenzeichen, z.B. bruchoperatoren<Bruch<T, Kuerzung>>() mit eigenen Erweiterungen
     @returns Das errechnete Endergebnis
     @pre term ist ein gültiger Term in Postfixnotation
  */
-template<typename T> Bruch<T> berechneNaechstenTerm( std::istream& term ) {
-    std::vector<Bruch<T>> zahlenstapel;
-    char c;
+template<typename T, typename Kuerzung = KuerzeNie, typename Tabelle> Bruch<T, Kuerzung> berechneNaechstenTerm( std::istream& term, const Tabelle& tabelle ) {
+    std::vector<Bruch<T, Kuerzung>> zahlenstapel;
+    std::string zeichen;
+    ///Größte Stapeltiefe des Terms, nur für die Instrumentierung
+    std::size_t tiefste = 0;
     ///Liest die Brüche aus term aus und führt die Rechenzeichen aus bis kein (nicht-leerer) char in term verblieben ist.
     while( clearWhitespacesCharFound( term ) ) {
         if( naechsteIstZahl( term ) ) {
             ///Einlesen und Abspeichern des Bruchs
-            Bruch<T> b;
+            Stoppuhr uhr( Phase::Zerlegen );
+            Bruch<T, Kuerzung> b;
             term >> b;
             zahlenstapel.push_back( b );
+            if constexpr( instrumentiert )
+                tiefste = std::max( tiefste, zahlenstapel.size() );
         } else {
-            ///Einlesen und auswerten des Rechenzeichens
-            term >> c;
-            switch( c ) {
-                case '+': {
-                        berechneOperation( zahlenstapel, add<Bruch<T>> );
-                        break;
-                    }
-                case '-': {
-                        berechneOperation( zahlenstapel, sub<Bruch<T>> );
-                        break;
-                    }
-                case '*': {
-                        berechneOperation( zahlenstapel, mul<Bruch<T>> );
-                        break;
-                    }
-                case '/': {
-                        berechneOperation( zahlenstapel, div<Bruch<T>> );
-                        break;
-                    }
-                case 'k': {
-                        berechneOperation( zahlenstapel, kuerzeBruch<T> );
-                        break;
-                    }
-                default:
-                    throw std::runtime_error( "Es wurde ein unbekanntes Zeichen eingegeben: " + std::string( 1, c ) );
+            ///Einlesen und auswerten der Rechenzeichen
+            leseRechenzeichen( term, zeichen );
+            Stoppuhr uhr( Phase::Rechnen );
+            for( std::string_view rest( zeichen ); !rest.empty(); ) {
+                if constexpr( instrumentiert )
+                    tabelle.finde( rest, [&zahlenstapel]( const auto& eintrag ) {
+                        erfasseRechenzeichen( eintrag.name, zahlenstapel.data(), zahlenstapel.size(), getStellen<Bruch<T, Kuerzung>>( eintrag ) );
+                    } );
+                const std::size_t laenge = tabelle.wendeAn( rest, zahlenstapel );
+                if( laenge == 0 )
+                    throw std::runtime_error( "Es wurde ein unbekanntes Zeichen eingegeben: " + std::string( 1, rest[0] ) );
+                rest.remove_prefix( laenge );
             }
         }
     }
     ///Falls nicht genau ein Bruch am Ende des Terms verblieben ist, wird eine entsprechende Exception geworfen.
     if( 1 < zahlenstapel.size() )
         throw std::runtime_error( "Es sind nicht genug Operatoren für diese Berechnung." );
+    if constexpr( instrumentiert )
+        erfasseTerm( tiefste );
     if( 0 == zahlenstapel.size() )
         //Alternative: Werfen eines entsprechenden Fehlers
         //throw std::runtime_error( "Es wurde keine Zahl eingegeben." );
-        return Bruch<T>( 0 );
-    Bruch<T> b = zahlenstapel.front();
+        return Bruch<T, Kuerzung>( 0 );
+    Bruch<T, Kuerzung> b = zahlenstapel.front();
     b.kuerzeBruch();
     return b;
 }
 
+/**
+    @brief Berechnet das Ergebnis von term.
+    Die Funktion liest den Term aus dem Eingangsstrom term und berechnet das Ergebnis mit den Rechenzeichen aus bruchoperatoren.
+    Die Zahlen des Terms werden als Brüche interpretiert. Der Term muss in Postfixnotation übergeben werden.
+    Das Endergebnis wird vollständig gekürzt zurückgegeben.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse (KuerzeNie, KuerzeImmer oder KuerzeAbBitbreite)
+    @param term: der zu berechnende Term
+    @returns Das errechnete Endergebnis
+    @pre term ist ein gültiger Term in Postfixnotation
+ */
+template<typename T, typename Kuerzung = KuerzeNie> Bruch<T, Kuerzung> berechneNaechstenTerm( std::istream& term ) {
+    return berechneNaechstenTerm<T, Kuerzung>( term, Bruchoperatoren<Bruch<T, Kuerzung>>::tabelle );
+}
+
+/**
+    @brief Berechnet das Ergebnis von term, ohne Exceptions zu werfen.
+    Fehler im Term werden nicht als Exception, sondern als Fehlercode mit Position zurückgegeben (siehe Termrechner::berechneOhneAusnahme).
+    Für Eingaben mit vielen fehlerhaften Termen entfallen so das Erzeugen der Fehlermeldung und das Abwickeln des Stacks.
+    Berechnet wird mit einem Termrechner je Thread, dessen Zahlenstapel über alle Terme erhalten bleibt.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @param term: der zu berechnende Term
+    @returns Das errechnete Endergebnis oder den Fehler
+ */
+template<typename T, typename Kuerzung = KuerzeNie> Termergebnis<Bruch<T, Kuerzung>> berechneNaechstenTermOhneAusnahme( std::string_view term ) {
+    ///Jeder Thread behält seinen Termrechner, damit der Zahlenstapel nicht für jeden Term neu angelegt werden muss.
+    thread_local Termrechner<T, Kuerzung> rechner;
+    return rechner.berechneOhneAusnahme( term );
+}
+
+/**
+    @brief Berechnet das Ergebnis von term.
+    Die Funktion arbeitet wie berechneNaechstenTerm für einen std::istream, liest den Term aber mit dem Termzerleger direkt aus dem Text.
+    Die Zahlen werden mit std::from_chars gelesen, es entstehen keine Kopien und keine get/putback-Aufrufe. Grammatik und Fehlermeldungen sind dieselben.
+    Anders als beim Einlesen über einen std::istream wird eine Zahl, die nicht in T passt, nicht abgeschnitten, sondern mit einer Ueberlauf-Exception gemeldet.
+    Die Funktion ist eine dünne Hülle um berechneNaechstenTermOhneAusnahme, die einen Fehler als Exception wirft.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @param term: der zu berechnende Term
+    @returns Das errechnete Endergebnis
+    @pre term ist ein gültiger Term in Postfixnotation
+ */
+template<typename T, typename Kuerzung = KuerzeNie> Bruch<T, Kuerzung> berechneNaechstenTerm( std::string_view term ) {
+    Termergebnis<Bruch<T, Kuerzung>> ergebnis = berechneNaechstenTermOhneAusnahme<T, Kuerzung>( term );
+    if( !ergebnis )
+        wirfFehler( ergebnis.fehler, term, ergebnis.position, ergebnis.stellen );
+    return ergebnis.wert;
+}
+
+/**
+    @brief Berechnet das Ergebnis von term in Infixnotation, ohne Exceptions zu werfen.
+    Der Term wird wie bei Termrechner::berechneInfixOhneAusnahme in einem Durchgang direkt auf dem Zahlenstapel berechnet, ohne ihn vorher in Postfixnotation umzuschreiben.
+    Berechnet wird mit einem Termrechner je Thread, dessen Zahlen- und Operatorstapel über alle Terme erhalten bleiben.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @param term: der zu berechnende Term in Infixnotation, z.B. "(1/2 + 3/4) * -5/6"
+    @returns Das errechnete Endergebnis oder den Fehler
+ */
+template<typename T, typename Kuerzung = KuerzeNie> Termergebnis<Bruch<T, Kuerzung>> berechneInfixTermOhneAusnahme( std::string_view term ) {
+    thread_local Termrechner<T, Kuerzung> rechner;
+    return rechner.berechneInfixOhneAusnahme( term );
+}
+
+/**
+    @brief Berechnet das Ergebnis von term in Infixnotation.
+    Die Funktion ist eine dünne Hülle um berechneInfixTermOhneAusnahme, die einen Fehler als Exception wirft.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @param term: der zu berechnende Term in Infixnotation
+    @returns Das errechnete Endergebnis
+ */
+template<typename T, typename Kuerzung = KuerzeNie> Bruch<T, Kuerzung> berechneInfixTerm( std::string_view term ) {
+    Termergebnis<Bruch<T, Kuerzung>> ergebnis = berechneInfixTermOhneAusnahme<T, Kuerzung>( term );
+    if( !ergebnis )
+        wirfFehler( ergebnis.fehler, term, ergebnis.position, ergebnis.stellen );
+    return ergebnis.wert;
+}
+
+///Berechnung zur Kompilierzeit
+/**
+    @brief Testet, ob an position in term eine Zahl beginnt (Ziffer oder Minus mit direkt folgender Ziffer).
+ */
+constexpr bool istKonstanteZahl( std::string_view term, std::size_t position ) {
+    if( position < term.size() && term[position] == '-' )
+        position++;
+    return position < term.size() && term[position] >= '0' && term[position] <= '9';
+}
+
+/**
+    @brief Liest eine Ganzzahl ab position aus term und rückt position hinter sie vor.
+    Anders als std::from_chars ist die Funktion constexpr. Eine Zahl, die nicht in T passt, wird mit einer Ueberlauf-Exception gemeldet, zur Kompilierzeit also als Fehler beim Kompilieren.
+    @arg T: eingebauter Ganzzahltyp
+    @param term: Der Term
+    @param position: Beginn der Zahl, danach die Position hinter der Zahl
+    @returns Die Zahl
+    @pre istKonstanteZahl( term, position )
+ */
+template <typename T> constexpr T leseKonstanteZahl( std::string_view term, std::size_t& position ) {
+    const bool negativ = term[position] == '-';
+    if( negativ )
+        position++;
+    T zahl = 0;
+    ///Negative Zahlen werden nach unten aufgebaut, damit auch der kleinste Wert von T gelesen werden kann.
+    while( position < term.size() && term[position] >= '0' && term[position] <= '9' ) {
+        const T ziffer = static_cast<T>( term[position++] - '0' );
+        if( __builtin_mul_overflow( zahl, static_cast<T>( 10 ), &zahl ) )
+            throw Ueberlauf();
+        if( negativ ? __builtin_sub_overflow( zahl, ziffer, &zahl ) : __builtin_add_overflow( zahl, ziffer, &zahl ) )
+            throw Ueberlauf();
+    }
+    return zahl;
+}
+
+/**
+    @brief Berechnet einen konstanten Term, auf Wunsch schon beim Kompilieren.
+    Die Funktion ist constexpr und kann deshalb für Terme genutzt werden, die als Zeichenkettenliteral im Quelltext stehen:
+    "constexpr Bruch<int> b = berechneKonstantenTerm<int>( "1/3 1/6 + k" );" berechnet b vollständig beim Kompilieren, zur Laufzeit entstehen keine Kosten.
+    Grammatik und Ergebnis entsprechen berechneNaechstenTerm. Statt eines std::vector wird ein Stapel fester Größe genutzt.
+    Ein fehlerhafter Term (unbekanntes Zeichen, zu wenige Zahlen oder Operatoren, Division durch 0, eine Zahl, die nicht in T passt) wirft eine Exception. Zur Kompilierzeit ist das ein Fehler beim Kompilieren.
+    Ein Überlauf beim Rechnen wird nur beim Kompilieren erkannt und nur für vorzeichenbehaftete Typen, da er dort keinen konstanten Ausdruck ergibt.
+    Zur Laufzeit wird wie bei berechneNaechstenTerm nicht geprüft (z.B. läuft "2147483647 2 *" mit int über), vorzeichenlose Typen laufen auch beim Kompilieren still über.
+    Zur Laufzeit aufgerufen verhält sich die Funktion wie berechneNaechstenTerm, die Fehlermeldungen enthalten aber nicht das unbekannte Zeichen.
+    @arg T: eingebauter Ganzzahltyp für Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @arg Stapelgroesse: Anzahl der Zahlen, die gleichzeitig auf dem Stapel liegen können
+    @param term: der zu berechnende Term
+    @returns Das vollständig gekürzte Endergebnis
+ */
+template <typename T, typename Kuerzung = KuerzeNie, std::size_t Stapelgroesse = 32>
+constexpr Bruch<T, Kuerzung> berechneKonstantenTerm( std::string_view term ) {
+    static_assert( IstEingebauteGanzzahl<T>::value, "Konstante Terme können nur mit eingebauten Ganzzahltypen berechnet werden." );
+    Bruch<T, Kuerzung> zahlenstapel[Stapelgroesse];
+    std::size_t hoehe = 0;
+    std::size_t position = 0;
+    for( ;; ) {
+        while( position < term.size() && ( term[position] == ' ' || ( term[position] >= '\t' && term[position] <= '\r' ) ) )
+            position++;
+        if( position == term.size() )
+            break;
+        if( istKonstanteZahl( term, position ) ) {
+            if( hoehe == Stapelgroesse )
+                throw std::runtime_error( "Der Term enthält zu viele Zahlen gleichzeitig für den Stapel." );
+            const T zaehler = leseKonstanteZahl<T>( term, position );
+            ///Falls auf den Zähler ein Bruchstrich folgt, wird der Nenner ausgelesen. Ansonsten wird die Zahl als Ganze Zahl interpretiert.
+            if( position < term.size() && term[position] == '/' ) {
+                position++;
+                if( !istKonstanteZahl( term, position ) )
+                    throw std::runtime_error( "Der Ausdruck besitzt direkt nach einem Bruchstrich keine Zahl, obwohl ein Nenner erwartet wird." );
+                const T nenner = leseKonstanteZahl<T>( term, position );
+                zahlenstapel[hoehe++] = Bruch<T, Kuerzung>( nenner, zaehler );
+            } else
+                zahlenstapel[hoehe++] = Bruch<T, Kuerzung>( zaehler );
+            continue;
+        }
+        ///n-stellige Summe und n-stelliges Produkt wie im Termzerleger
+        const std::string_view rest = term.substr( position );
+        const bool summe = rest.substr( 0, 2 ) == "Σ" || rest.substr( 0, 3 ) == "sum";
+        if( summe || rest.substr( 0, 2 ) == "Π" || rest.substr( 0, 4 ) == "prod" ) {
+            position += rest[0] == 's' ? 3 : rest[0] == 'p' ? 4 : 2;
+            std::size_t anzahl = 0;
+            if( hoehe < 1 )
+                throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung." );
+            if( !leseAnzahl( zahlenstapel[hoehe - 1], hoehe - 1, anzahl ) )
+                throw std::runtime_error( "Vor einem n-stelligen Rechenzeichen (Σ, Π) muss die Anzahl als nicht negative ganze Zahl stehen." );
+            if( anzahl > hoehe - 1 )
+                throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung." );
+            hoehe -= anzahl + 1;
+            zahlenstapel[hoehe] = summe ? summiere( zahlenstapel + hoehe, anzahl ) : multipliziere( zahlenstapel + hoehe, anzahl );
+            hoehe++;
+            continue;
+        }
+        const char c = term[position++];
+        if( c == 'k' ) {
+            if( hoehe < 1 )
+                throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung mit 1 Stellen." );
+            zahlenstapel[hoehe - 1].kuerzeBruch();
+            continue;
+        }
+        if( c != '+' && c != '-' && c != '*' && c != '/' )
+            throw std::runtime_error( "Es wurde ein unbekanntes Zeichen eingegeben." );
+        if( hoehe < 2 )
+            throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung mit 2 Stellen." );
+        hoehe--;
+        switch( c ) {
+            case '+':
+                zahlenstapel[hoehe - 1] = zahlenstapel[hoehe - 1] + zahlenstapel[hoehe];
+                break;
+            case '-':
+                zahlenstapel[hoehe - 1] = zahlenstapel[hoehe - 1] - zahlenstapel[hoehe];
+                break;
+            case '*':
+                zahlenstapel[hoehe - 1] = zahlenstapel[hoehe - 1] * zahlenstapel[hoehe];
+                break;
+            default:
+                zahlenstapel[hoehe - 1] = zahlenstapel[hoehe - 1] / zahlenstapel[hoehe];
+        }
+    }
+    if( 1 < hoehe )
+        throw std::runtime_error( "Es sind nicht genug Operatoren für diese Berechnung." );
+    if( 0 == hoehe )
+        return Bruch<T, Kuerzung>( 0 );
+    Bruch<T, Kuerzung> b = zahlenstapel[0];
+    b.kuerzeBruch();
+    return b;
+}
+
+///Berechnung mit Überlaufschutz
+/**
+    @brief Ergebnis einer Berechnung mit Überlaufschutz.
+    Das Ergebnis liegt im schmalsten Datentyp vor, in dem der Term ohne Überlauf berechnet werden konnte.
+ */
+using GeprueftesErgebnis = std::variant<Bruch<long int>, Bruch<__int128>, Bruch<Langzahl>>;
+
+/**
+    @brief Gibt ein Ergebnis mit Überlaufschutz aus.
+    @param os: Der Ausgabestrom
+    @param ergebnis: Das auszugebende Ergebnis
+    @returns Den zusammengefügten Ausgabestrom
+ */
+std::ostream& operator << ( std::ostream& os, const GeprueftesErgebnis& ergebnis );
+
+/**
+    @brief Berechnet das Ergebnis von term und weicht bei einem Überlauf auf breitere Datentypen aus, ohne Exceptions zu werfen.
+    Der Term wird zunächst mit überlaufgeprüften long int berechnet. Passt das Ergebnis oder ein Zwischenergebnis nicht in 64 Bit, wird der Term mit __int128 neu berechnet.
+    Reichen auch 128 Bit nicht, wird er mit Langzahl exakt berechnet.
+    Terme, die in 64 Bit passen, bleiben damit auf dem schnellen Weg; nur bei einem Überlauf entstehen Zusatzkosten.
+    Andere Fehler im Term werden sofort als Fehlercode zurückgegeben.
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @param term: der zu berechnende Term in Postfixnotation
+    @param infix: True, wenn term in Infixnotation steht (siehe berechneInfixTermOhneAusnahme)
+    @returns Das errechnete, vollständig gekürzte Endergebnis oder den Fehler
+ */
+template <typename Kuerzung = KuerzeNie> Termergebnis<GeprueftesErgebnis> berechneTermMitUeberlaufschutzOhneAusnahme( std::string_view term, bool infix = false ) {
+    const auto ergebnis64 = infix ? berechneInfixTermOhneAusnahme<Geprueft<long int>, Kuerzung>( term ) : berechneNaechstenTermOhneAusnahme<Geprueft<long int>, Kuerzung>( term );
+    if( ergebnis64 )
+        return { entpacke( ergebnis64.wert ), Fehlercode::KeinFehler, 0 };
+    if( ergebnis64.fehler != Fehlercode::Ueberlauf )
+        return { GeprueftesErgebnis(), ergebnis64.fehler, ergebnis64.position, ergebnis64.stellen };
+    const auto ergebnis128 = infix ? berechneInfixTermOhneAusnahme<Geprueft<__int128>, Kuerzung>( term ) : berechneNaechstenTermOhneAusnahme<Geprueft<__int128>, Kuerzung>( term );
+    if( ergebnis128 )
+        return { entpacke( ergebnis128.wert ), Fehlercode::KeinFehler, 0 };
+    if( ergebnis128.fehler != Fehlercode::Ueberlauf )
+        return { GeprueftesErgebnis(), ergebnis128.fehler, ergebnis128.position, ergebnis128.stellen };
+    const auto ergebnis = infix ? berechneInfixTermOhneAusnahme<Langzahl, Kuerzung>( term ) : berechneNaechstenTermOhneAusnahme<Langzahl, Kuerzung>( term );
+    if( !ergebnis )
+        return { GeprueftesErgebnis(), ergebnis.fehler, ergebnis.position, ergebnis.stellen };
+    return { Bruch<Langzahl>( ergebnis.wert.getNenner(), ergebnis.wert.getZaehler() ), Fehlercode::KeinFehler, 0 };
+}
+
+/**
+    @brief Berechnet das Ergebnis von term und weicht bei einem Überlauf auf breitere Datentypen aus.
+    Die Funktion ist eine dünne Hülle um berechneTermMitUeberlaufschutzOhneAusnahme, die einen Fehler als Exception wirft.
+    @arg Kuerzung: Kürzungsstrategie für die Zwischenergebnisse
+    @param term: der zu berechnende Term in Postfixnotation
+    @returns Das errechnete, vollständig gekürzte Endergebnis
+    @pre term ist ein gültiger Term in Postfixnotation
+ */
+template <typename Kuerzung = KuerzeNie> GeprueftesErgebnis berechneTermMitUeberlaufschutz( std::string_view term ) {
+    Termergebnis<GeprueftesErgebnis> ergebnis = berechneTermMitUeberlaufschutzOhneAusnahme<Kuerzung>( term );
+    if( !ergebnis )
+        wirfFehler( ergebnis.fehler, term, ergebnis.position, ergebnis.stellen );
+    return ergebnis.wert;
+}
+
 #endif // BRUCHBERECHNER_H
@@ -0,0 +1,82 @@
+#ifndef BRUCHOPERATOREN_H
+#define BRUCHOPERATOREN_H
+
+#include <cstddef>
+
+#include "Bruch.h"
+#include "Berechner.h"
+#include "Termergebnis.h"
+
+/**
+    @brief Dividiert die obersten zwei Brüche auf dem Stapel.
+    Als Stapeloperation kann die Division auf 0 prüfen und sie als Fehlercode melden, statt dass der Konstruktor des Kehrwerts eine Exception wirft.
+    @arg B: Typ der Brüche
+    @param stapel: Der Zahlenstapel
+    @param hoehe: Die Anzahl der Zahlen auf dem Stapel
+    @returns ZuWenigZahlen, DivisionDurchNull oder KeinFehler
+ */
+template <typename B> Fehlercode dividiere( B* stapel, std::size_t& hoehe ) {
+    if( hoehe < 2 )
+        return Fehlercode::ZuWenigZahlen;
+    if( stapel[hoehe - 1].getZaehler() == 0 )
+        return Fehlercode::DivisionDurchNull;
+    hoehe--;
+    stapel[hoehe - 1] = stapel[hoehe - 1] / stapel[hoehe];
+    return Fehlercode::KeinFehler;
+}
+
+/**
+    @brief Berechnet eine n-stellige Summe bzw. ein n-stelliges Produkt auf dem Stapel.
+    Oben auf dem Stapel liegt die Anzahl N, darunter die N Operanden. Alle werden entfernt und durch das Ergebnis von summiere bzw. multipliziere ersetzt.
+    @arg B: Typ der Brüche
+    @arg Reduktion: '+' für die Summe, '*' für das Produkt
+    @param stapel: Der Zahlenstapel
+    @param hoehe: Die Anzahl der Zahlen auf dem Stapel
+    @returns ZuWenigZahlen, UngueltigeAnzahl oder KeinFehler
+ */
+template <char Reduktion, typename B> Fehlercode berechneReduktion( B* stapel, std::size_t& hoehe ) {
+    std::size_t anzahl = 0;
+    if( hoehe < 1 )
+        return Fehlercode::ZuWenigZahlen;
+    if( !leseAnzahl( stapel[hoehe - 1], hoehe - 1, anzahl ) )
+        return Fehlercode::UngueltigeAnzahl;
+    if( anzahl > hoehe - 1 )
+        return Fehlercode::ZuWenigZahlen;
+    hoehe -= anzahl + 1;
+    stapel[hoehe] = Reduktion == '+' ? summiere( stapel + hoehe, anzahl ) : multipliziere( stapel + hoehe, anzahl );
+    hoehe++;
+    return Fehlercode::KeinFehler;
+}
+
+/**
+    @brief Gibt die Operatortabelle der Rechenzeichen für Terme in Postfixnotation zurück.
+    Die Tabelle enthält "+", "-", "*", "/", "k" (Kürzen) sowie die n-stellige Summe "N Σ" bzw. "N sum" und das n-stellige Produkt "N Π" bzw. "N prod".
+    Sie kann mit Operatortabelle::erweitere um eigene Rechenzeichen ergänzt werden.
+    @arg B: Typ der Brüche
+    @returns Die Tabelle
+ */
+template <typename B> constexpr auto bruchoperatoren() {
+    return Operatortabelle(
+               definiereOperator( "+", []( const B& a, const B& b ) -> B { return a + b; } ),
+               definiereOperator( "-", []( const B& a, const B& b ) -> B { return a - b; } ),
+               definiereOperator( "*", []( const B& a, const B& b ) -> B { return a * b; } ),
+               definiereOperator( "/", []( B* stapel, std::size_t& hoehe ) { return dividiere( stapel, hoehe ); }, 2 ),
+               definiereOperator( "k", []( const B& b ) -> B { return kuerzeBruch( b ); } ),
+               definiereOperator( "Σ", []( B* stapel, std::size_t& hoehe ) { return berechneReduktion<'+'>( stapel, hoehe ); } ),
+               definiereOperator( "sum", []( B* stapel, std::size_t& hoehe ) { return berechneReduktion<'+'>( stapel, hoehe ); } ),
+               definiereOperator( "Π", []( B* stapel, std::size_t& hoehe ) { return berechneReduktion<'*'>( stapel, hoehe ); } ),
+               definiereOperator( "prod", []( B* stapel, std::size_t& hoehe ) { return berechneReduktion<'*'>( stapel, hoehe ); } ) );
+}
+
+/**
+    @brief Stellt die Operatortabelle als Konstante eines Typs bereit, damit sie als Templateparameter übergeben werden kann (z.B. an Termrechner).
+    Eigene Rechenzeichen werden mit einem Typ derselben Form eingeführt:
+    "struct MeineOperatoren { static constexpr auto tabelle = bruchoperatoren<Bruch<long int>>().erweitere( definiereOperator( "max", ... ) ); };"
+    Da die Tabelle zur Kompilierzeit feststeht, werden die Namen beim Suchen als Konstanten verglichen und die Operationen direkt eingesetzt.
+    @arg B: Typ der Brüche
+ */
+template <typename B> struct Bruchoperatoren {
+    static constexpr auto tabelle = bruchoperatoren<B>();
+};
+
+#endif // BRUCHOPERATOREN_H
@@ -0,0 +1,112 @@
+#ifndef BRUCHSORTIERUNG_H
+#define BRUCHSORTIERUNG_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "Bruch.h"
+
+/**
+    @brief Bildet einen 64-Bit-Schlüssel, dessen Reihenfolge der der Werte folgt.
+    Der Schlüssel ist floor(zaehler/nenner * 2^32), also der ganzzahlige Anteil mit 32 Nachkommabits, begrenzt auf den Bereich von std::int64_t und um 2^63 verschoben, damit er vorzeichenlos verglichen werden kann.
+    Aus a < b folgt schluessel(a) <= schluessel(b). Gleiche Schlüssel entstehen für Werte, die näher als 2^-32 beieinander liegen oder deren Betrag 2^31 übersteigt, diese müssen exakt verglichen werden.
+    @arg T: eingebauter Ganzzahltyp mit höchstens 64 Bit
+    @arg K: Kürzungsstrategie
+ */
+template <typename T, typename K> std::uint64_t getSortierschluessel( const Bruch<T, K>& b ) {
+    using U = std::uint64_t;
+    const T z = b.getZaehler();
+    const T n = b.getNenner();
+    const bool negativ = ( z < 0 ) != ( n < 0 );
+    ///Beträge ohne Überlauf beim kleinsten Wert des Typs
+    const U betragZ = z < 0 ? U( 0 ) - static_cast<U>( z ) : static_cast<U>( z );
+    const U betragN = n < 0 ? U( 0 ) - static_cast<U>( n ) : static_cast<U>( n );
+    const U ganz = betragZ / betragN;
+    const U rest = betragZ % betragN;
+    ///Für negative Werte wird der Nachkommaanteil aufgerundet, damit nach dem Negieren abgerundet ist.
+    U nachkomma = 0;
+    if( rest != 0 ) {
+        const U rundung = negativ ? betragN - 1 : 0;
+        nachkomma = betragN <= 0xffffffffu ? ( ( rest << 32 ) + rundung ) / betragN
+                    : static_cast<U>( ( ( static_cast<unsigned __int128>( rest ) << 32 ) + rundung ) / betragN );
+    }
+    __int128 wert = ( static_cast<__int128>( ganz ) << 32 ) + nachkomma;
+    if( negativ )
+        wert = -wert;
+    const __int128 grenze = static_cast<__int128>( 1 ) << 63;
+    wert = std::min( std::max( wert, -grenze ), grenze - 1 );
+    return static_cast<U>( static_cast<std::int64_t>( wert ) ) ^ ( U( 1 ) << 63 );
+}
+
+/**
+    @brief Sortiert die Brüche aufsteigend nach ihrem Wert.
+    Für eingebaute Ganzzahlen bis 64 Bit wird zu jedem Bruch einmal ein Schlüssel (getSortierschluessel) gebildet. Sortiert wird dann nach den Schlüsseln mit einem Radixsort über 11-Bit-Ziffern,
+    Ziffern, die bei allen Schlüsseln gleich sind, werden übersprungen. Nur Brüche mit gleichem Schlüssel werden danach noch exakt über Kreuz verglichen.
+    So fallen statt n log n Vergleiche mit je zwei 128-Bit-Produkten n Divisionen und einige lineare Durchläufe an.
+    Für andere Typen und kleine Vektoren wird std::sort mit dem Operator < genutzt. Wie bei std::sort ist die Reihenfolge wertgleicher Brüche (z.B. 1/2 und 2/4) nicht festgelegt.
+    @arg T: Speicherklasse von Zähler und Nenner
+    @arg K: Kürzungsstrategie
+    @param brueche: Die Brüche, werden sortiert
+ */
+template <typename T, typename K> void sortiereBrueche( std::vector<Bruch<T, K>>& brueche ) {
+    if constexpr( IstEingebauteGanzzahl<T>::value && sizeof( T ) <= sizeof( std::uint64_t ) ) {
+        const std::size_t anzahl = brueche.size();
+        if( anzahl >= 256 && anzahl <= 0xffffffffu ) {
+            struct Eintrag {
+                std::uint64_t schluessel;
+                std::uint32_t index;
+            };
+            std::vector<Eintrag> eintraege( anzahl ), puffer( anzahl );
+            ///Die Häufigkeiten aller sechs Ziffern werden in einem Durchlauf gezählt.
+            constexpr int bits = 11;
+            constexpr int ziffern = ( 64 + bits - 1 ) / bits;
+            constexpr std::uint64_t maske = ( 1u << bits ) - 1;
+            std::vector<std::array<std::size_t, 1u << bits>> haeufigkeiten( ziffern );
+            for( std::size_t i = 0; i < anzahl; i++ ) {
+                const std::uint64_t schluessel = getSortierschluessel( brueche[i] );
+                eintraege[i] = { schluessel, static_cast<std::uint32_t>( i ) };
+                for( int ziffer = 0; ziffer < ziffern; ziffer++ )
+                    haeufigkeiten[ziffer][( schluessel >> ( bits * ziffer ) ) & maske]++;
+            }
+            for( int ziffer = 0; ziffer < ziffern; ziffer++ ) {
+                auto& haeufigkeit = haeufigkeiten[ziffer];
+                if( haeufigkeit[( eintraege.front().schluessel >> ( bits * ziffer ) ) & maske] == anzahl )
+                    continue;
+                std::size_t position = 0;
+                for( auto& h : haeufigkeit ) {
+                    const std::size_t n = h;
+                    h = position;
+                    position += n;
+                }
+                for( const Eintrag& e : eintraege )
+                    puffer[haeufigkeit[( e.schluessel >> ( bits * ziffer ) ) & maske]++] = e;
+                eintraege.swap( puffer );
+            }
+            ///Gleiche Schlüssel sagen nichts über die Reihenfolge, diese Abschnitte werden exakt sortiert.
+            for( std::size_t anfang = 0; anfang < anzahl; ) {
+                std::size_t ende = anfang + 1;
+                while( ende < anzahl && eintraege[ende].schluessel == eintraege[anfang].schluessel )
+                    ende++;
+                if( ende - anfang > 1 )
+                    std::sort( eintraege.begin() + anfang, eintraege.begin() + ende, [&brueche]( const Eintrag& a, const Eintrag& b ) {
+                        return brueche[a.index] < brueche[b.index];
+                    } );
+                anfang = ende;
+            }
+            std::vector<Bruch<T, K>> sortiert;
+            sortiert.reserve( anzahl );
+            for( const Eintrag& e : eintraege )
+                sortiert.push_back( brueche[e.index] );
+            brueche.swap( sortiert );
+            return;
+        }
+    }
+    std::sort( brueche.begin(), brueche.end(), []( const Bruch<T, K>& a, const Bruch<T, K>& b ) {
+        return a < b;
+    } );
+}
+
+#endif // BRUCHSORTIERUNG_H
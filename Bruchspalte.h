@@ -0,0 +1,304 @@
+#ifndef BRUCHSPALTE_H
+#define BRUCHSPALTE_H
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include "Bruch.h"
+#include "Termprogramm.h"
+
+/**
+    @brief Eine Spalte von Brüchen, gespeichert als getrennte Felder für Zähler und Nenner.
+    Anders als std::vector<Bruch<T>> liegen alle Zähler und alle Nenner jeweils hintereinander im Speicher.
+    Die Rechenschleifen über solche Spalten haben keine Abhängigkeiten zwischen den Zeilen und keine Sprünge, sodass der Compiler sie vektorisieren kann.
+    @arg T: Datentyp von Zähler und Nenner
+ */
+template <typename T> class Bruchspalte {
+    public:
+        /**
+            @brief Konstruktor: Legt eine Spalte mit groesse Zeilen an, die alle 0 sind.
+            @param groesse: Anzahl der Zeilen
+         */
+        explicit Bruchspalte( std::size_t groesse = 0 )
+            : zaehler( groesse, T( 0 ) ), nenner( groesse, T( 1 ) ) {
+        }
+
+        /**
+            @brief Konstruktor: Übernimmt die Brüche aus einem Vektor.
+            @arg K: Kürzungsstrategie der Brüche
+            @param brueche: Die Brüche
+         */
+        template <typename K> explicit Bruchspalte( const std::vector<Bruch<T, K>>& brueche )
+            : Bruchspalte( brueche.size() ) {
+            for( std::size_t i = 0; i < brueche.size(); i++ )
+                setze( i, brueche[i] );
+        }
+
+        std::size_t getGroesse() const {
+            return zaehler.size();
+        }
+
+        /**
+            @brief Schreibt einen Bruch in Zeile i.
+            @pre i < getGroesse()
+         */
+        template <typename K> void setze( std::size_t i, const Bruch<T, K>& b ) {
+            zaehler[i] = b.getZaehler();
+            nenner[i] = b.getNenner();
+        }
+
+        /**
+            @brief Gibt den Bruch in Zeile i zurück.
+            @pre i < getGroesse()
+         */
+        Bruch<T> getBruch( std::size_t i ) const {
+            return Bruch<T>( nenner[i], zaehler[i] );
+        }
+
+        T* getZaehler() {
+            return zaehler.data();
+        }
+        const T* getZaehler() const {
+            return zaehler.data();
+        }
+        T* getNenner() {
+            return nenner.data();
+        }
+        const T* getNenner() const {
+            return nenner.data();
+        }
+
+    private:
+        std::vector<T> zaehler;
+        std::vector<T> nenner;
+};
+
+///Rechenkerne auf Zeilenbereichen. Das Ergebnis wird jeweils in a geschrieben, b darf nicht mit a überlappen (__restrict__).
+///Wie bei KuerzeNie wird in den Kernen nicht gekürzt (auch nicht über Kreuz), damit die Schleifen frei von ggT-Berechnungen und Sprüngen bleiben.
+/**
+    @brief Addiert die Zeilen von b auf die Zeilen von a.
+    @arg T: Datentyp von Zähler und Nenner
+    @param za, na: Zähler und Nenner der Summanden a, danach der Summe
+    @param zb, nb: Zähler und Nenner der Summanden b
+    @param anzahl: Anzahl der Zeilen
+ */
+template <typename T> void addiereZeilen( T* __restrict__ za, T* __restrict__ na, const T* __restrict__ zb, const T* __restrict__ nb, std::size_t anzahl ) {
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        za[i] = za[i] * nb[i] + zb[i] * na[i];
+        na[i] = na[i] * nb[i];
+    }
+}
+
+/**
+    @brief Subtrahiert die Zeilen von b von den Zeilen von a.
+ */
+template <typename T> void subtrahiereZeilen( T* __restrict__ za, T* __restrict__ na, const T* __restrict__ zb, const T* __restrict__ nb, std::size_t anzahl ) {
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        za[i] = za[i] * nb[i] - zb[i] * na[i];
+        na[i] = na[i] * nb[i];
+    }
+}
+
+/**
+    @brief Multipliziert die Zeilen von a mit den Zeilen von b.
+ */
+template <typename T> void multipliziereZeilen( T* __restrict__ za, T* __restrict__ na, const T* __restrict__ zb, const T* __restrict__ nb, std::size_t anzahl ) {
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        za[i] = za[i] * zb[i];
+        na[i] = na[i] * nb[i];
+    }
+}
+
+/**
+    @brief Dividiert die Zeilen von a durch die Zeilen von b.
+    @throws std::runtime_error, falls ein Zähler von b 0 ist
+ */
+template <typename T> void dividiereZeilen( T* __restrict__ za, T* __restrict__ na, const T* __restrict__ zb, const T* __restrict__ nb, std::size_t anzahl ) {
+    ///Die Prüfung auf 0 läuft als eigene Schleife ohne vorzeitigen Abbruch, damit beide Schleifen vektorisiert werden können.
+    std::size_t nullen = 0;
+    for( std::size_t i = 0; i < anzahl; i++ )
+        nullen += zb[i] == 0;
+    if( nullen != 0 )
+        throw std::runtime_error( "Eine Division durch Null (bzw. eine Null im Nenner) ist nicht möglich." );
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        za[i] = za[i] * nb[i];
+        na[i] = na[i] * zb[i];
+    }
+}
+
+/**
+    @brief Kürzt jede Zeile vollständig, wie Bruch::kuerzeBruch.
+ */
+template <typename T> void kuerzeZeilen( T* z, T* n, std::size_t anzahl ) {
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        Bruch<T> b( n[i], z[i] );
+        b.kuerzeBruch();
+        z[i] = b.getZaehler();
+        n[i] = b.getNenner();
+    }
+}
+
+/**
+    @brief Wendet die Kürzungsstrategie K auf jede Zeile an.
+    Für KuerzeNie entfällt die Schleife ganz.
+ */
+template <typename K, typename T> void wendeKuerzungAn( T* z, T* n, std::size_t anzahl ) {
+    if constexpr( !std::is_same<K, KuerzeNie>::value ) {
+        for( std::size_t i = 0; i < anzahl; i++ ) {
+            Bruch<T, K> b( n[i], z[i] );
+            K::nachOperation( b );
+            z[i] = b.getZaehler();
+            n[i] = b.getNenner();
+        }
+    }
+}
+
+/**
+    @brief Prüft, ob zwei Spalten gleich lang sind.
+    @throws std::logic_error, wenn nicht
+ */
+template <typename T> void pruefeGleicheGroesse( const Bruchspalte<T>& a, const Bruchspalte<T>& b ) {
+    if( a.getGroesse() != b.getGroesse() )
+        throw std::logic_error( "Die Spalten haben unterschiedlich viele Zeilen." );
+}
+
+///Rechenoperationen auf ganzen Spalten, das Ergebnis steht danach in a.
+template <typename T> void addiereSpalte( Bruchspalte<T>& a, const Bruchspalte<T>& b ) {
+    pruefeGleicheGroesse( a, b );
+    addiereZeilen( a.getZaehler(), a.getNenner(), b.getZaehler(), b.getNenner(), a.getGroesse() );
+}
+template <typename T> void subtrahiereSpalte( Bruchspalte<T>& a, const Bruchspalte<T>& b ) {
+    pruefeGleicheGroesse( a, b );
+    subtrahiereZeilen( a.getZaehler(), a.getNenner(), b.getZaehler(), b.getNenner(), a.getGroesse() );
+}
+template <typename T> void multipliziereSpalte( Bruchspalte<T>& a, const Bruchspalte<T>& b ) {
+    pruefeGleicheGroesse( a, b );
+    multipliziereZeilen( a.getZaehler(), a.getNenner(), b.getZaehler(), b.getNenner(), a.getGroesse() );
+}
+template <typename T> void dividiereSpalte( Bruchspalte<T>& a, const Bruchspalte<T>& b ) {
+    pruefeGleicheGroesse( a, b );
+    dividiereZeilen( a.getZaehler(), a.getNenner(), b.getZaehler(), b.getNenner(), a.getGroesse() );
+}
+template <typename T> void kuerzeSpalte( Bruchspalte<T>& a ) {
+    kuerzeZeilen( a.getZaehler(), a.getNenner(), a.getGroesse() );
+}
+
+/**
+    @brief Gibt die Summe aller Zeilen zurück.
+    Die Zwischensummen werden nach jedem Schritt gekürzt, da sonst die Nenner schnell überlaufen.
+    @arg T: Datentyp von Zähler und Nenner
+    @param spalte: Die Spalte
+    @returns Die vollständig gekürzte Summe
+ */
+template <typename T> Bruch<T> summeDerSpalte( const Bruchspalte<T>& spalte ) {
+    Bruch<T, KuerzeImmer> summe( 0 );
+    for( std::size_t i = 0; i < spalte.getGroesse(); i++ )
+        summe = summe + Bruch<T, KuerzeImmer>( spalte.getNenner()[i], spalte.getZaehler()[i] );
+    return Bruch<T>( summe.getNenner(), summe.getZaehler() );
+}
+
+/**
+    @brief Gibt das Produkt aller Zeilen zurück.
+    Wie beim Operator * wird über Kreuz gekürzt.
+    @arg T: Datentyp von Zähler und Nenner
+    @param spalte: Die Spalte
+    @returns Das vollständig gekürzte Produkt
+ */
+template <typename T> Bruch<T> produktDerSpalte( const Bruchspalte<T>& spalte ) {
+    Bruch<T, KuerzeImmer> produkt( 1 );
+    for( std::size_t i = 0; i < spalte.getGroesse(); i++ )
+        produkt = produkt * Bruch<T, KuerzeImmer>( spalte.getNenner()[i], spalte.getZaehler()[i] );
+    return Bruch<T>( produkt.getNenner(), produkt.getZaehler() );
+}
+
+/**
+    @brief Berechnet ein Termprogramm spaltenweise für viele Belegungen.
+    Statt jede Belegung einzeln durch das Programm zu schicken, wird jeder Befehl auf einen ganzen Block von Zeilen angewandt. Der Stapel besteht dabei aus Bruchspalten.
+    Die Blöcke sind so klein, dass der Stapel im Cache bleibt. Nach jeder Rechenoperation wird die Kürzungsstrategie K des Programms angewandt, das Ergebnis ist vollständig gekürzt.
+    Anders als bei Termprogramm::berechne wird beim Multiplizieren und Dividieren nicht über Kreuz gekürzt. Bei KuerzeNie können Zwischenergebnisse daher früher überlaufen.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg K: Kürzungsstrategie des Programms
+    @param programm: Das übersetzte Programm
+    @param variablen: Eine Spalte je Variable, in der Reihenfolge der Namen beim Übersetzen. Alle Spalten müssen gleich lang sein.
+    @returns Eine Spalte mit dem Ergebnis jeder Zeile (bzw. einer Zeile, wenn das Programm keine Variablen hat)
+ */
+template <typename T, typename K> Bruchspalte<T> berechneSpaltenweise( const Termprogramm<T, K>& programm, const std::vector<Bruchspalte<T>>& variablen ) {
+    if( variablen.size() < programm.getAnzahlVariablen() )
+        throw std::logic_error( "Die Belegung enthält nicht für jede Variable einen Wert." );
+    const std::size_t zeilen = programm.getAnzahlVariablen() == 0 ? 1 : variablen.front().getGroesse();
+    for( std::size_t v = 0; v < programm.getAnzahlVariablen(); v++ )
+        pruefeGleicheGroesse( variablen[v], variablen.front() );
+    constexpr std::size_t blockgroesse = 256;
+    std::vector<Bruchspalte<T>> stapel( programm.getStapeltiefe(), Bruchspalte<T>( blockgroesse ) );
+    Bruchspalte<T> ergebnis( zeilen );
+    for( std::size_t anfang = 0; anfang < zeilen; anfang += blockgroesse ) {
+        const std::size_t anzahl = std::min( blockgroesse, zeilen - anfang );
+        std::size_t hoehe = 0;
+        for( const auto& a : programm.getAnweisungen() ) {
+            switch( a.befehl ) {
+                case Befehl::Konstante: {
+                        const auto& konstante = programm.getKonstanten()[a.index];
+                        std::fill_n( stapel[hoehe].getZaehler(), anzahl, konstante.getZaehler() );
+                        std::fill_n( stapel[hoehe].getNenner(), anzahl, konstante.getNenner() );
+                        hoehe++;
+                        break;
+                    }
+                case Befehl::Variable:
+                    std::copy_n( variablen[a.index].getZaehler() + anfang, anzahl, stapel[hoehe].getZaehler() );
+                    std::copy_n( variablen[a.index].getNenner() + anfang, anzahl, stapel[hoehe].getNenner() );
+                    hoehe++;
+                    break;
+                case Befehl::Kuerzen:
+                    kuerzeZeilen( stapel[hoehe - 1].getZaehler(), stapel[hoehe - 1].getNenner(), anzahl );
+                    break;
+                case Befehl::Summe:
+                case Befehl::Produkt: {
+                        ///Die n-stelligen Befehle werden als Folge zweistelliger Operationen in die unterste ihrer Spalten berechnet.
+                        const bool summe = a.befehl == Befehl::Summe;
+                        if( a.index == 0 ) {
+                            std::fill_n( stapel[hoehe].getZaehler(), anzahl, T( summe ? 0 : 1 ) );
+                            std::fill_n( stapel[hoehe].getNenner(), anzahl, T( 1 ) );
+                            hoehe++;
+                            break;
+                        }
+                        const std::size_t unten = hoehe - a.index;
+                        T* za = stapel[unten].getZaehler();
+                        T* na = stapel[unten].getNenner();
+                        for( std::size_t i = unten + 1; i < hoehe; i++ ) {
+                            if( summe )
+                                addiereZeilen( za, na, stapel[i].getZaehler(), stapel[i].getNenner(), anzahl );
+                            else
+                                multipliziereZeilen( za, na, stapel[i].getZaehler(), stapel[i].getNenner(), anzahl );
+                            wendeKuerzungAn<K>( za, na, anzahl );
+                        }
+                        hoehe = unten + 1;
+                        break;
+                    }
+                default: {
+                        hoehe--;
+                        T* za = stapel[hoehe - 1].getZaehler();
+                        T* na = stapel[hoehe - 1].getNenner();
+                        const T* zb = stapel[hoehe].getZaehler();
+                        const T* nb = stapel[hoehe].getNenner();
+                        if( a.befehl == Befehl::Addition )
+                            addiereZeilen( za, na, zb, nb, anzahl );
+                        else if( a.befehl == Befehl::Subtraktion )
+                            subtrahiereZeilen( za, na, zb, nb, anzahl );
+                        else if( a.befehl == Befehl::Multiplikation )
+                            multipliziereZeilen( za, na, zb, nb, anzahl );
+                        else
+                            dividiereZeilen( za, na, zb, nb, anzahl );
+                        wendeKuerzungAn<K>( za, na, anzahl );
+                    }
+            }
+        }
+        std::copy_n( stapel.front().getZaehler(), anzahl, ergebnis.getZaehler() + anfang );
+        std::copy_n( stapel.front().getNenner(), anzahl, ergebnis.getNenner() + anfang );
+    }
+    kuerzeSpalte( ergebnis );
+    return ergebnis;
+}
+
+#endif // BRUCHSPALTE_H
@@ -0,0 +1,91 @@
+#include "Ergebniscache.h"
+
+#include <algorithm>
+
+/**
+    @brief Schätzt den Speicherbedarf eines Eintrags.
+    Zum Schlüssel und zum Knoten kommen Listen- und Hashtabellenverwaltung (etwa vier Zeiger) und bei einer Langzahl ihre Ziffern hinzu.
+ */
+static std::size_t schaetzeGroesse( std::string_view schluessel, const Ergebniscache::Eintrag& eintrag ) {
+    std::size_t groesse = schluessel.size() + sizeof( Ergebniscache::Eintrag ) + sizeof( std::string ) + 2 * sizeof( std::size_t ) + 4 * sizeof( void* );
+    if( const auto* gross = std::get_if<Bruch<Langzahl>>( &eintrag.wert ) )
+        groesse += ( bitbreite( gross->getZaehler() ) + bitbreite( gross->getNenner() ) ) / 8;
+    return groesse;
+}
+
+Ergebniscache::Ergebniscache( std::size_t speicherbudget, std::size_t anzahlSegmente )
+    : budgetJeSegment( speicherbudget / std::max<std::size_t>( 1, anzahlSegmente ) ), treffer( 0 ), fehlgriffe( 0 ), verdraengt( 0 ) {
+    for( std::size_t i = 0; i < std::max<std::size_t>( 1, anzahlSegmente ); i++ )
+        segmente.push_back( std::make_unique<Segment>() );
+}
+
+void Ergebniscache::normalisiere( std::string_view term, std::string& schluessel ) {
+    schluessel.clear();
+    bool leerraum = false;
+    for( const char c : term ) {
+        if( c == ' ' || ( c >= '\t' && c <= '\r' ) ) {
+            leerraum = true;
+            continue;
+        }
+        if( leerraum && !schluessel.empty() )
+            schluessel += ' ';
+        leerraum = false;
+        schluessel += c;
+    }
+}
+
+bool Ergebniscache::suche( std::string_view schluessel, Eintrag& eintrag ) {
+    Segment& segment = getSegment( schluessel );
+    {
+        std::lock_guard<std::mutex> wache( segment.sperre );
+        const auto gefunden = segment.index.find( schluessel );
+        if( gefunden != segment.index.end() ) {
+            ///Der Knoten wandert nach vorne, ohne kopiert zu werden. Iteratoren und Schlüssel bleiben gültig.
+            segment.reihenfolge.splice( segment.reihenfolge.begin(), segment.reihenfolge, gefunden->second );
+            eintrag = gefunden->second->eintrag;
+            treffer.fetch_add( 1, std::memory_order_relaxed );
+            return true;
+        }
+    }
+    fehlgriffe.fetch_add( 1, std::memory_order_relaxed );
+    return false;
+}
+
+void Ergebniscache::speichere( std::string_view schluessel, const Eintrag& eintrag ) {
+    const std::size_t groesse = schaetzeGroesse( schluessel, eintrag );
+    if( groesse > budgetJeSegment )
+        return;
+    Segment& segment = getSegment( schluessel );
+    std::lock_guard<std::mutex> wache( segment.sperre );
+    ///Ein anderer Thread kann denselben Term gleichzeitig berechnet und schon gespeichert haben.
+    if( segment.index.count( schluessel ) != 0 )
+        return;
+    while( segment.belegt + groesse > budgetJeSegment ) {
+        const Knoten& aeltester = segment.reihenfolge.back();
+        segment.belegt -= aeltester.groesse;
+        segment.index.erase( aeltester.schluessel );
+        segment.reihenfolge.pop_back();
+        verdraengt.fetch_add( 1, std::memory_order_relaxed );
+    }
+    segment.reihenfolge.push_front( { std::string( schluessel ), eintrag, groesse } );
+    segment.index.emplace( segment.reihenfolge.front().schluessel, segment.reihenfolge.begin() );
+    segment.belegt += groesse;
+}
+
+std::size_t Ergebniscache::getBelegt() const {
+    std::size_t belegt = 0;
+    for( const auto& segment : segmente ) {
+        std::lock_guard<std::mutex> wache( segment->sperre );
+        belegt += segment->belegt;
+    }
+    return belegt;
+}
+
+std::size_t Ergebniscache::getAnzahl() const {
+    std::size_t anzahl = 0;
+    for( const auto& segment : segmente ) {
+        std::lock_guard<std::mutex> wache( segment->sperre );
+        anzahl += segment->reihenfolge.size();
+    }
+    return anzahl;
+}
@@ -0,0 +1,120 @@
+#ifndef ERGEBNISCACHE_H
+#define ERGEBNISCACHE_H
+
+#include <string>
+#include <string_view>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+#include "Bruchberechner.h"
+#include "Termergebnis.h"
+
+/**
+    @brief Speichert die Ergebnisse zuletzt berechneter Terme, damit wiederholte Terme nicht erneut zerlegt und berechnet werden müssen.
+    Schlüssel ist der normalisierte Term (siehe normalisiere), Terme, die sich nur im Leerraum unterscheiden, teilen sich also einen Eintrag.
+    Gespeichert wird das gekürzte Ergebnis oder der Fehler. Ist das Speicherbudget erschöpft, wird der am längsten nicht genutzte Eintrag verdrängt (LRU).
+    Der Cache ist in Segmente mit eigener Sperre und eigenem Anteil am Budget aufgeteilt. Threads, die auf verschiedene Terme zugreifen, behindern sich so selten gegenseitig.
+    Alle Methoden dürfen von mehreren Threads gleichzeitig aufgerufen werden.
+ */
+class Ergebniscache {
+    public:
+        /**
+            @brief Ein gespeichertes Ergebnis.
+            Bei einem Fehler wird statt der Position das Zeichen an der Fehlerposition behalten, da die Position im normalisierten Term nicht zu jedem Term mit diesem Schlüssel passt.
+         */
+        struct Eintrag {
+            GeprueftesErgebnis wert;
+            Fehlercode fehler = Fehlercode::KeinFehler;
+            ///Zeichen an der Fehlerposition für haengeFehlermeldungAn
+            char fehlerzeichen = 0;
+            ///Stellenzahl aus dem Termergebnis für haengeFehlermeldungAn
+            std::size_t stellen = 0;
+        };
+
+        /**
+            @brief Konstruktor: Legt einen leeren Cache an.
+            @param speicherbudget: Größte Anzahl Bytes für Schlüssel, Ergebnisse und Verwaltung zusammen (geschätzt)
+            @param segmente: Anzahl der unabhängig gesperrten Segmente, default = 16
+         */
+        explicit Ergebniscache( std::size_t speicherbudget, std::size_t segmente = 16 );
+        Ergebniscache( const Ergebniscache& ) = delete;
+        Ergebniscache& operator = ( const Ergebniscache& ) = delete;
+
+        /**
+            @brief Schreibt den Schlüssel zu term nach schluessel.
+            Jede Folge von whitespace chars wird zu einem Leerzeichen, am Anfang und Ende entfällt sie. Die Grammatik unterscheidet nur, ob zwischen zwei Zeichen Leerraum steht, nicht welcher.
+            @param term: Der Term
+            @param schluessel: Der Schlüssel, wird vorher geleert. Bei wiederholter Nutzung derselben Zeichenkette wird kein Speicher angefordert.
+         */
+        static void normalisiere( std::string_view term, std::string& schluessel );
+
+        /**
+            @brief Sucht das Ergebnis zu schluessel und markiert den Eintrag als zuletzt genutzt.
+            @param schluessel: Der normalisierte Term
+            @param eintrag: Das gespeicherte Ergebnis, falls gefunden
+            @returns True, wenn der Schlüssel gefunden wurde
+         */
+        bool suche( std::string_view schluessel, Eintrag& eintrag );
+
+        /**
+            @brief Speichert das Ergebnis zu schluessel und verdrängt, falls nötig, die am längsten nicht genutzten Einträge.
+            Ein Eintrag, der allein das Budget eines Segments übersteigt, wird nicht gespeichert.
+            @param schluessel: Der normalisierte Term
+            @param eintrag: Das Ergebnis
+         */
+        void speichere( std::string_view schluessel, const Eintrag& eintrag );
+
+        ///Anzahl der erfolgreichen Suchen
+        std::size_t getTreffer() const {
+            return treffer.load( std::memory_order_relaxed );
+        }
+        ///Anzahl der erfolglosen Suchen
+        std::size_t getFehlgriffe() const {
+            return fehlgriffe.load( std::memory_order_relaxed );
+        }
+        ///Anzahl der verdrängten Einträge
+        std::size_t getVerdraengt() const {
+            return verdraengt.load( std::memory_order_relaxed );
+        }
+        /**
+            @brief Gibt den geschätzten Speicherbedarf aller Einträge zurück.
+         */
+        std::size_t getBelegt() const;
+        /**
+            @brief Gibt die Anzahl der Einträge zurück.
+         */
+        std::size_t getAnzahl() const;
+
+    private:
+        struct Knoten {
+            std::string schluessel;
+            Eintrag eintrag;
+            std::size_t groesse;
+        };
+
+        struct Segment {
+            mutable std::mutex sperre;
+            ///Vorne der zuletzt genutzte Eintrag
+            std::list<Knoten> reihenfolge;
+            ///Die Schlüssel zeigen in die Knoten der Liste.
+            std::unordered_map<std::string_view, std::list<Knoten>::iterator> index;
+            std::size_t belegt = 0;
+        };
+
+        Segment& getSegment( std::string_view schluessel ) {
+            return *segmente[std::hash<std::string_view>()( schluessel ) % segmente.size()];
+        }
+
+        std::vector<std::unique_ptr<Segment>> segmente;
+        std::size_t budgetJeSegment;
+        std::atomic<std::size_t> treffer;
+        std::atomic<std::size_t> fehlgriffe;
+        std::atomic<std::size_t> verdraengt;
+};
+
+#endif // ERGEBNISCACHE_H
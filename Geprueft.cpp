@@ -0,0 +1,49 @@
+#include "Geprueft.h"
+
+std::ostream& operator << ( std::ostream& os, __int128 zahl ) {
+    ///Der Betrag wird vorzeichenlos gebildet, damit auch die kleinste Zahl -2^127 ausgegeben werden kann.
+    unsigned __int128 rest = zahl < 0 ? -static_cast<unsigned __int128>( zahl ) : static_cast<unsigned __int128>( zahl );
+    char ziffern[40];
+    char* ende = ziffern + sizeof( ziffern );
+    char* anfang = ende;
+    do {
+        *--anfang = static_cast<char>( '0' + rest % 10 );
+        rest /= 10;
+    } while( rest != 0 );
+    if( zahl < 0 )
+        *--anfang = '-';
+    return os.write( anfang, ende - anfang );
+}
+
+std::istream& operator >> ( std::istream& is, __int128& zahl ) {
+    const unsigned __int128 groessterBetrag = ~static_cast<unsigned __int128>( 0 ) >> 1;
+    std::istream::sentry wache( is );
+    if( !wache )
+        return is;
+    bool negativ = false;
+    if( is.peek() == '-' || is.peek() == '+' )
+        negativ = is.get() == '-';
+    unsigned __int128 betrag = 0;
+    bool ziffernGefunden = false;
+    bool zuGross = false;
+    while( is.peek() >= '0' && is.peek() <= '9' ) {
+        const unsigned ziffer = is.get() - '0';
+        ziffernGefunden = true;
+        ///Nach einem Überlauf werden die restlichen Ziffern noch gelesen, aber nicht mehr addiert.
+        if( zuGross || betrag > ( groessterBetrag + 1 - ziffer ) / 10 )
+            zuGross = true;
+        else
+            betrag = betrag * 10 + ziffer;
+    }
+    if( !ziffernGefunden ) {
+        zahl = 0;
+        is.setstate( std::ios::failbit );
+    } else if( zuGross || ( !negativ && betrag > groessterBetrag ) ) {
+        zahl = negativ ? static_cast<__int128>( ~groessterBetrag ) : static_cast<__int128>( groessterBetrag );
+        is.setstate( std::ios::failbit );
+    } else
+        zahl = negativ ? static_cast<__int128>( -betrag ) : static_cast<__int128>( betrag );
+    if( is.peek() == std::char_traits<char>::eof() )
+        is.setstate( std::ios::eofbit );
+    return is;
+}
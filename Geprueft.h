@@ -0,0 +1,196 @@
+#ifndef GEPRUEFT_H
+#define GEPRUEFT_H
+
+#include <iostream>
+#include <stdexcept>
+
+#include "Bruch.h"
+
+/**
+    @brief Gibt eine 128-Bit-Zahl aus.
+    Die Standardbibliothek kennt im strikten C++17-Modus keine Ein- und Ausgabe für __int128.
+    @param os: Der Ausgabestrom
+    @param zahl: Die auszugebende Zahl
+    @returns Den zusammengefügten Ausgabestrom
+ */
+std::ostream& operator << ( std::ostream& os, __int128 zahl );
+
+/**
+    @brief Liest eine 128-Bit-Zahl ein.
+    Der Operator verhält sich wie das Einlesen eingebauter Ganzzahlen: Führende whitespace chars werden übersprungen, ist die Zahl zu groß, wird das failbit gesetzt und der größt- bzw. kleinstmögliche Wert geschrieben.
+    @param is: Der Eingabestrom
+    @param zahl: Die eingelesene Zahl
+    @returns Den Eingabestrom
+ */
+std::istream& operator >> ( std::istream& is, __int128& zahl );
+
+/**
+    @brief Wird geworfen, wenn eine überlaufgeprüfte Rechnung den Wertebereich verlässt.
+ */
+class Ueberlauf : public std::overflow_error {
+    public:
+        Ueberlauf()
+            : std::overflow_error( "Das Ergebnis ist für den Datentyp zu groß." ) {
+        }
+};
+
+/**
+    @brief Ganzzahl mit Überlaufprüfung.
+    Die Klasse verpackt eine eingebaute Ganzzahl und prüft jede Rechenoperation mit den __builtin_*_overflow Funktionen des Compilers.
+    Statt still überzulaufen, wird eine Ueberlauf-Exception geworfen. Damit lässt sich z.B. Bruch<Geprueft<long int>> rechnen und bei einem Überlauf auf einen breiteren Typ wechseln.
+    @arg T: eingebauter Ganzzahltyp
+ */
+template <typename T>
+class Geprueft {
+    public:
+        /**
+            @brief Konstruktor: Initialisiert die Zahl mit wert.
+            @param wert: Der Wert, default = 0
+         */
+        Geprueft( const T& wert = 0 )
+            : wert( wert ) {
+        }
+
+        /**
+            @brief Gibt den verpackten Wert zurück.
+            @returns Der Wert
+         */
+        T getWert() const {
+            return wert;
+        }
+
+        ///Rechenoperationen
+        friend Geprueft operator + ( const Geprueft& a, const Geprueft& b ) {
+            T ergebnis;
+            if( __builtin_add_overflow( a.wert, b.wert, &ergebnis ) )
+                throw Ueberlauf();
+            return ergebnis;
+        }
+        friend Geprueft operator - ( const Geprueft& a, const Geprueft& b ) {
+            T ergebnis;
+            if( __builtin_sub_overflow( a.wert, b.wert, &ergebnis ) )
+                throw Ueberlauf();
+            return ergebnis;
+        }
+        friend Geprueft operator * ( const Geprueft& a, const Geprueft& b ) {
+            T ergebnis;
+            if( __builtin_mul_overflow( a.wert, b.wert, &ergebnis ) )
+                throw Ueberlauf();
+            return ergebnis;
+        }
+        friend Geprueft operator / ( const Geprueft& a, const Geprueft& b ) {
+            ///Der einzige Überlauf bei der Division ist der kleinste Wert geteilt durch -1.
+            if( istVorzeichenbehaftet && b.wert == static_cast<T>( -1 ) )
+                return -a;
+            return a.wert / b.wert;
+        }
+        friend Geprueft operator % ( const Geprueft& a, const Geprueft& b ) {
+            if( istVorzeichenbehaftet && b.wert == static_cast<T>( -1 ) )
+                return Geprueft();
+            return a.wert % b.wert;
+        }
+        Geprueft operator - () const {
+            return Geprueft() - *this;
+        }
+        Geprueft& operator += ( const Geprueft& b ) {
+            return *this = *this + b;
+        }
+        Geprueft& operator -= ( const Geprueft& b ) {
+            return *this = *this - b;
+        }
+        Geprueft& operator *= ( const Geprueft& b ) {
+            return *this = *this * b;
+        }
+        Geprueft& operator /= ( const Geprueft& b ) {
+            return *this = *this / b;
+        }
+
+        ///Vergleiche
+        friend bool operator == ( const Geprueft& a, const Geprueft& b ) {
+            return a.wert == b.wert;
+        }
+        friend bool operator != ( const Geprueft& a, const Geprueft& b ) {
+            return a.wert != b.wert;
+        }
+        friend bool operator < ( const Geprueft& a, const Geprueft& b ) {
+            return a.wert < b.wert;
+        }
+        friend bool operator > ( const Geprueft& a, const Geprueft& b ) {
+            return a.wert > b.wert;
+        }
+        friend bool operator <= ( const Geprueft& a, const Geprueft& b ) {
+            return a.wert <= b.wert;
+        }
+        friend bool operator >= ( const Geprueft& a, const Geprueft& b ) {
+            return a.wert >= b.wert;
+        }
+
+        ///Ein- und Ausgabe
+        friend std::ostream& operator << ( std::ostream& os, const Geprueft& zahl ) {
+            return os << zahl.wert;
+        }
+        /**
+            @brief Liest die Zahl ein.
+            Ist die eingelesene Zahl zu groß für T, wird eine Ueberlauf-Exception geworfen, statt den Wert still abzuschneiden.
+         */
+        friend std::istream& operator >> ( std::istream& is, Geprueft& zahl ) {
+            if( !( is >> zahl.wert ) && ( zahl.wert == groessterWert || zahl.wert == kleinsterWert ) )
+                throw Ueberlauf();
+            return is;
+        }
+
+    private:
+        ///std::numeric_limits kennt __int128 im strikten C++17-Modus nicht, deshalb werden die Grenzen selbst bestimmt.
+        static constexpr bool istVorzeichenbehaftet = static_cast<T>( -1 ) < 0;
+        static constexpr typename VorzeichenloseForm<T>::Typ alleBits = static_cast<typename VorzeichenloseForm<T>::Typ>( ~typename VorzeichenloseForm<T>::Typ( 0 ) );
+        static constexpr T groessterWert = static_cast<T>( istVorzeichenbehaftet ? alleBits >> 1 : alleBits );
+        static constexpr T kleinsterWert = istVorzeichenbehaftet ? static_cast<T>( -groessterWert - 1 ) : T( 0 );
+        T wert;
+};
+
+/**
+    @brief Gibt größten gemeinsamen Teiler der Zahlen zurück.
+    Der ggT kann nicht überlaufen und wird deshalb direkt auf den verpackten Werten berechnet.
+    @arg T: verpackter Ganzzahltyp
+    @param a: Zahl a
+    @param b: Zahl b
+    @returns Größten gemeinsamen Teiler
+ */
+template <typename T> Geprueft<T> ggt( const Geprueft<T>& a, const Geprueft<T>& b ) {
+    return ggt( a.getWert(), b.getWert() );
+}
+
+/**
+    @brief Gibt die Bitbreite der verpackten Zahl zurück.
+    @arg T: verpackter Ganzzahltyp
+    @param x: Die Zahl
+    @returns Bitbreite von x
+ */
+template <typename T> int bitbreite( const Geprueft<T>& x ) {
+    return bitbreite( x.getWert() );
+}
+
+/**
+    @brief Entfernt die Überlaufprüfung aus einem Bruch.
+    @arg T: verpackter Ganzzahltyp
+    @arg K: Kürzungsstrategie
+    @param b: Der geprüfte Bruch
+    @returns Bruch mit den ungeprüften Werten und ohne Kürzungsstrategie
+ */
+template <typename T, typename K> Bruch<T> entpacke( const Bruch<Geprueft<T>, K>& b ) {
+    return Bruch<T>( b.getNenner().getWert(), b.getZaehler().getWert() );
+}
+
+/**
+    @brief Vergleicht die Werte zweier geprüfter Brüche exakt.
+    Verglichen werden die entpackten Werte, so greift der Vergleich eingebauter Ganzzahlen, der nicht überlaufen kann. Die Produkte über Kreuz würden sonst geprüft und könnten Ueberlauf werfen.
+    @arg A: verpackter Ganzzahltyp von a
+    @arg B: verpackter Ganzzahltyp von b
+    @arg K: Kürzungsstrategie
+    @returns -1, 0 oder 1, wenn a kleiner, gleich oder größer als b ist
+ */
+template <typename A, typename B, typename K> int vergleiche( const Bruch<Geprueft<A>, K>& a, const Bruch<Geprueft<B>, K>& b ) {
+    return vergleiche( entpacke( a ), entpacke( b ) );
+}
+
+#endif // GEPRUEFT_H
@@ -0,0 +1,65 @@
+#include "Instrumentierung.h"
+
+#include <iostream>
+#include <csignal>
+#include <cstdlib>
+#include <algorithm>
+
+Messwerte messwerte {};
+
+///Wird im Signalhandler gesetzt und von zusammenfassungAngefordert zurückgesetzt.
+static volatile std::sig_atomic_t angefordert = 0;
+
+void setzeMesswerteZurueck() {
+    for( auto& wert : messwerte.zaehler )
+        wert.store( 0, std::memory_order_relaxed );
+    for( auto& wert : messwerte.nanosekunden )
+        wert.store( 0, std::memory_order_relaxed );
+    for( auto& wert : messwerte.bitbreiten )
+        wert.store( 0, std::memory_order_relaxed );
+    for( auto& wert : messwerte.stapeltiefen )
+        wert.store( 0, std::memory_order_relaxed );
+}
+
+void schreibeZusammenfassung( std::ostream& os ) {
+    static const char* const zaehlernamen[] = { "Addition", "Subtraktion", "Multiplikation", "Division", "Kuerzen", "Summe", "Produkt", "ggT-Aufrufe", "ggT-Schritte", "Terme" };
+    static const char* const phasennamen[] = { "Zerlegen", "Rechnen" };
+    auto wert = []( const std::atomic<std::uint64_t>& zahl ) {
+        return zahl.load( std::memory_order_relaxed );
+    };
+    os << "Instrumentierung:\n";
+    for( std::size_t i = 0; i < static_cast<std::size_t>( Zaehler::Anzahl ); i++ )
+        os << "  " << zaehlernamen[i] << ": " << wert( messwerte.zaehler[i] ) << "\n";
+    for( std::size_t i = 0; i < static_cast<std::size_t>( Phase::Anzahl ); i++ )
+        os << "  " << phasennamen[i] << ": " << wert( messwerte.nanosekunden[i] ) / 1e6 << " ms\n";
+    os << "  Bitbreite der Operanden:\n";
+    for( std::size_t i = 0; i <= Messwerte::maximaleBitbreite + 1; i++ )
+        if( wert( messwerte.bitbreiten[i] ) != 0 )
+            os << "    " << ( i > Messwerte::maximaleBitbreite ? ">" : "" ) << std::min( i, Messwerte::maximaleBitbreite ) << " Bit: " << wert( messwerte.bitbreiten[i] ) << "\n";
+    os << "  Stapeltiefe der Terme:\n";
+    for( std::size_t i = 0; i <= Messwerte::maximaleStapeltiefe + 1; i++ )
+        if( wert( messwerte.stapeltiefen[i] ) != 0 )
+            os << "    " << ( i > Messwerte::maximaleStapeltiefe ? ">" : "" ) << std::min( i, Messwerte::maximaleStapeltiefe ) << ": " << wert( messwerte.stapeltiefen[i] ) << "\n";
+    os.flush();
+}
+
+/**
+    @brief Signalhandler: Vermerkt nur den Wunsch nach einer Zusammenfassung, da die Ausgabe selbst nicht signalsicher ist.
+ */
+static void merkeAnforderung( int ) {
+    angefordert = 1;
+}
+
+void aktiviereZusammenfassung( int signalnummer ) {
+    std::atexit( []() {
+        schreibeZusammenfassung( std::cerr );
+    } );
+    std::signal( signalnummer, merkeAnforderung );
+}
+
+bool zusammenfassungAngefordert() {
+    if( angefordert == 0 )
+        return false;
+    angefordert = 0;
+    return true;
+}
@@ -0,0 +1,172 @@
+#ifndef INSTRUMENTIERUNG_H
+#define INSTRUMENTIERUNG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+///Die Instrumentierung wird nur übersetzt, wenn mit -DBRUCHRECHNER_INSTRUMENTIERUNG kompiliert wird.
+///Alle Messpunkte stehen hinter "if constexpr( instrumentiert )", ohne das Makro erzeugen sie also keinen Code.
+#ifdef BRUCHRECHNER_INSTRUMENTIERUNG
+constexpr bool instrumentiert = true;
+#else
+constexpr bool instrumentiert = false;
+#endif
+
+/**
+    @brief Gezählte Ereignisse.
+ */
+enum class Zaehler : std::uint8_t {
+    Addition,
+    Subtraktion,
+    Multiplikation,
+    Division,
+    Kuerzen,
+    Summe,                  ///n-stellige Summe (Σ, sum)
+    Produkt,                ///n-stelliges Produkt (Π, prod)
+    GgtAufrufe,
+    GgtSchritte,            ///Schleifendurchläufe in ggt über alle Aufrufe
+    Terme,
+    Anzahl
+};
+
+/**
+    @brief Gemessene Phasen der Berechnung eines Terms.
+ */
+enum class Phase : std::uint8_t {
+    Zerlegen,               ///Einlesen der Zahlen und Rechenzeichen
+    Rechnen,                ///Ausführen der Rechenzeichen
+    Anzahl
+};
+
+/**
+    @brief Die gesammelten Messwerte.
+    Alle Werte sind atomar, da die Stapelverarbeitung auf mehreren Threads rechnet. Es wird mit memory_order_relaxed gezählt, die Werte sind also erst nach dem Ende der Threads exakt.
+ */
+struct Messwerte {
+    ///Größte Bitbreite mit eigenem Fach, breitere Zahlen (Langzahl) landen im letzten Fach.
+    static constexpr std::size_t maximaleBitbreite = 128;
+    static constexpr std::size_t maximaleStapeltiefe = 64;
+
+    std::atomic<std::uint64_t> zaehler[static_cast<std::size_t>( Zaehler::Anzahl )];
+    std::atomic<std::uint64_t> nanosekunden[static_cast<std::size_t>( Phase::Anzahl )];
+    ///Anzahl der Operanden je Bitbreite (das Maximum aus Zähler und Nenner)
+    std::atomic<std::uint64_t> bitbreiten[maximaleBitbreite + 2];
+    ///Anzahl der Terme je größter Stapeltiefe
+    std::atomic<std::uint64_t> stapeltiefen[maximaleStapeltiefe + 2];
+};
+
+extern Messwerte messwerte;
+
+/**
+    @brief Zählt ein Ereignis.
+    Die Funktion kann in constexpr-Funktionen aufgerufen werden, bei der Berechnung zur Kompilierzeit wird nichts gezählt.
+    @param z: Das Ereignis
+    @param anzahl: Wie oft es eingetreten ist
+ */
+constexpr void zaehle( Zaehler z, std::uint64_t anzahl = 1 ) {
+    if( !__builtin_is_constant_evaluated() )
+        messwerte.zaehler[static_cast<std::size_t>( z )].fetch_add( anzahl, std::memory_order_relaxed );
+}
+
+/**
+    @brief Bestimmt den Zähler zum Rechenzeichen name ("+", "-", "*", "/", "k", "Σ" bzw. "sum" oder "Π" bzw. "prod").
+    @returns Den Zähler, Zaehler::Anzahl für andere (z.B. eigene) Rechenzeichen
+ */
+constexpr Zaehler getZaehler( std::string_view name ) {
+    if( name == "+" )
+        return Zaehler::Addition;
+    if( name == "-" )
+        return Zaehler::Subtraktion;
+    if( name == "*" )
+        return Zaehler::Multiplikation;
+    if( name == "/" )
+        return Zaehler::Division;
+    if( name == "k" )
+        return Zaehler::Kuerzen;
+    if( name == "Σ" || name == "sum" )
+        return Zaehler::Summe;
+    if( name == "Π" || name == "prod" )
+        return Zaehler::Produkt;
+    return Zaehler::Anzahl;
+}
+
+/**
+    @brief Zählt das Rechenzeichen name, andere als die von getZaehler erkannten werden nicht gezählt.
+ */
+inline void zaehleRechenzeichen( std::string_view name ) {
+    const Zaehler z = getZaehler( name );
+    if( z != Zaehler::Anzahl )
+        zaehle( z );
+}
+
+/**
+    @brief Trägt einen Operanden mit bits Bit in das Histogramm der Bitbreiten ein.
+ */
+inline void erfasseBitbreite( int bits ) {
+    const std::size_t fach = bits < 0 ? 0 : static_cast<std::size_t>( bits );
+    messwerte.bitbreiten[fach <= Messwerte::maximaleBitbreite ? fach : Messwerte::maximaleBitbreite + 1].fetch_add( 1, std::memory_order_relaxed );
+}
+
+/**
+    @brief Zählt einen fertigen Term und trägt seine größte Stapeltiefe in das Histogramm ein.
+ */
+inline void erfasseTerm( std::size_t stapeltiefe ) {
+    zaehle( Zaehler::Terme );
+    messwerte.stapeltiefen[stapeltiefe <= Messwerte::maximaleStapeltiefe ? stapeltiefe : Messwerte::maximaleStapeltiefe + 1].fetch_add( 1, std::memory_order_relaxed );
+}
+
+/**
+    @brief Misst die Zeit vom Anlegen bis zum Zerstören und rechnet sie der Phase zu.
+    Ohne Instrumentierung liest die Stoppuhr die Uhr nicht, das Objekt wird dann vom Compiler vollständig entfernt.
+ */
+class Stoppuhr {
+    public:
+        explicit Stoppuhr( Phase phase )
+            : phase( phase ) {
+            if constexpr( instrumentiert )
+                start = std::chrono::steady_clock::now();
+        }
+
+        ~Stoppuhr() {
+            if constexpr( instrumentiert ) {
+                const auto dauer = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start );
+                messwerte.nanosekunden[static_cast<std::size_t>( phase )].fetch_add( dauer.count(), std::memory_order_relaxed );
+            }
+        }
+
+        Stoppuhr( const Stoppuhr& ) = delete;
+        Stoppuhr& operator = ( const Stoppuhr& ) = delete;
+
+    private:
+        Phase phase;
+        std::chrono::steady_clock::time_point start;
+};
+
+/**
+    @brief Setzt alle Messwerte auf 0.
+ */
+void setzeMesswerteZurueck();
+
+/**
+    @brief Gibt eine Zusammenfassung der Messwerte aus.
+    Ausgegeben werden die Zähler, die Zeit je Phase sowie die nicht leeren Fächer der Histogramme.
+    @param os: Der Ausgabestrom
+ */
+void schreibeZusammenfassung( std::ostream& os );
+
+/**
+    @brief Schreibt die Zusammenfassung beim Programmende nach std::cerr und fordert sie zusätzlich beim Signal signalnummer an.
+    Im Signalhandler wird nur vermerkt, dass eine Zusammenfassung gewünscht ist. Das Programm muss zusammenfassungAngefordert() regelmäßig abfragen, z.B. nach jeder Zeile.
+    @param signalnummer: Das Signal, z.B. SIGUSR1
+ */
+void aktiviereZusammenfassung( int signalnummer );
+
+/**
+    @brief Gibt zurück, ob seit dem letzten Aufruf das Signal für eine Zusammenfassung eingetroffen ist.
+ */
+bool zusammenfassungAngefordert();
+
+#endif // INSTRUMENTIERUNG_H
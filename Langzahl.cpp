@@ -0,0 +1,574 @@
+#include "Langzahl.h"
+
+#include <string>
+#include <utility>
+#include <algorithm>
+
+using Ziffern = Langzahl::Ziffern;
+
+///Rechenfunktionen auf Beträgen
+///Alle Ziffernfolgen speichern die niederwertigste 32-Bit-Ziffer zuerst und haben keine führenden Nullen.
+
+/**
+    @brief Zerlegt einen 64-Bit-Betrag in Ziffern.
+ */
+static Ziffern alsZiffern( std::uint64_t betrag ) {
+    Ziffern z;
+    while( betrag != 0 ) {
+        z.push_back( static_cast<std::uint32_t>( betrag ) );
+        betrag >>= 32;
+    }
+    return z;
+}
+
+/**
+    @brief Entfernt führende Nullen.
+ */
+static void entferneNullen( Ziffern& z ) {
+    while( !z.empty() && z.back() == 0 )
+        z.pop_back();
+}
+
+/**
+    @brief Vergleicht zwei Beträge.
+    @returns -1, 0 oder 1, wenn a kleiner, gleich oder größer als b ist
+ */
+static int vergleiche( const Ziffern& a, const Ziffern& b ) {
+    if( a.size() != b.size() )
+        return a.size() < b.size() ? -1 : 1;
+    for( std::size_t i = a.size(); i-- > 0; )
+        if( a[i] != b[i] )
+            return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+/**
+    @brief Addiert zwei Beträge.
+ */
+static Ziffern addiereBetrag( const Ziffern& a, const Ziffern& b ) {
+    const Ziffern& laenger = a.size() < b.size() ? b : a;
+    const Ziffern& kuerzer = a.size() < b.size() ? a : b;
+    Ziffern summe( laenger.size() + 1 );
+    std::uint64_t uebertrag = 0;
+    for( std::size_t i = 0; i < laenger.size(); i++ ) {
+        uebertrag += static_cast<std::uint64_t>( laenger[i] ) + ( i < kuerzer.size() ? kuerzer[i] : 0 );
+        summe[i] = static_cast<std::uint32_t>( uebertrag );
+        uebertrag >>= 32;
+    }
+    summe[laenger.size()] = static_cast<std::uint32_t>( uebertrag );
+    entferneNullen( summe );
+    return summe;
+}
+
+/**
+    @brief Subtrahiert b von a in a.
+    @pre a >= b
+ */
+static void subtrahiereBetrag( Ziffern& a, const Ziffern& b ) {
+    std::int64_t borgen = 0;
+    for( std::size_t i = 0; i < a.size(); i++ ) {
+        std::int64_t differenz = static_cast<std::int64_t>( a[i] ) - ( i < b.size() ? b[i] : 0 ) - borgen;
+        borgen = differenz < 0;
+        a[i] = static_cast<std::uint32_t>( differenz );
+        if( i >= b.size() && !borgen )
+            break;
+    }
+    entferneNullen( a );
+}
+
+/**
+    @brief Multipliziert zwei Beträge nach der Schulmethode.
+ */
+static Ziffern multipliziereBetrag( const Ziffern& a, const Ziffern& b ) {
+    if( a.empty() || b.empty() )
+        return Ziffern();
+    Ziffern produkt( a.size() + b.size() );
+    for( std::size_t i = 0; i < a.size(); i++ ) {
+        std::uint64_t uebertrag = 0;
+        for( std::size_t j = 0; j < b.size(); j++ ) {
+            uebertrag += static_cast<std::uint64_t>( a[i] ) * b[j] + produkt[i + j];
+            produkt[i + j] = static_cast<std::uint32_t>( uebertrag );
+            uebertrag >>= 32;
+        }
+        produkt[i + b.size()] = static_cast<std::uint32_t>( uebertrag );
+    }
+    entferneNullen( produkt );
+    return produkt;
+}
+
+/**
+    @brief Teilt a in a durch eine einzelne Ziffer und gibt den Rest zurück.
+    @pre divisor != 0
+ */
+static std::uint32_t dividiereDurchZiffer( Ziffern& a, std::uint32_t divisor ) {
+    std::uint64_t rest = 0;
+    for( std::size_t i = a.size(); i-- > 0; ) {
+        const std::uint64_t teil = ( rest << 32 ) | a[i];
+        a[i] = static_cast<std::uint32_t>( teil / divisor );
+        rest = teil % divisor;
+    }
+    entferneNullen( a );
+    return static_cast<std::uint32_t>( rest );
+}
+
+/**
+    @brief Multipliziert a mit faktor und addiert summand, beides in a.
+ */
+static void multipliziereAddiere( Ziffern& a, std::uint32_t faktor, std::uint32_t summand ) {
+    std::uint64_t uebertrag = summand;
+    for( auto& ziffer : a ) {
+        uebertrag += static_cast<std::uint64_t>( ziffer ) * faktor;
+        ziffer = static_cast<std::uint32_t>( uebertrag );
+        uebertrag >>= 32;
+    }
+    if( uebertrag != 0 )
+        a.push_back( static_cast<std::uint32_t>( uebertrag ) );
+}
+
+/**
+    @brief Teilt u durch v mit Rest nach Knuth, TAOCP Bd. 2, 4.3.1, Algorithmus D.
+    Die Umsetzung folgt divmnu aus Hacker's Delight (Warren), Kap. 9-2.
+    @pre v hat mindestens zwei Ziffern und u ist mindestens so lang wie v
+ */
+static void dividiereBetrag( const Ziffern& u, const Ziffern& v, Ziffern& quotient, Ziffern& rest ) {
+    const std::size_t n = v.size();
+    const std::size_t m = u.size();
+    ///Normalisieren, sodass das höchste Bit von v gesetzt ist. Dann ist die Schätzung qDach höchstens um 2 zu groß.
+    const int s = __builtin_clz( v[n - 1] );
+    Ziffern vn( n );
+    for( std::size_t i = n - 1; i > 0; i-- )
+        vn[i] = ( v[i] << s ) | static_cast<std::uint32_t>( static_cast<std::uint64_t>( v[i - 1] ) >> ( 32 - s ) );
+    vn[0] = v[0] << s;
+    Ziffern un( m + 1 );
+    un[m] = static_cast<std::uint32_t>( static_cast<std::uint64_t>( u[m - 1] ) >> ( 32 - s ) );
+    for( std::size_t i = m - 1; i > 0; i-- )
+        un[i] = ( u[i] << s ) | static_cast<std::uint32_t>( static_cast<std::uint64_t>( u[i - 1] ) >> ( 32 - s ) );
+    un[0] = u[0] << s;
+    const std::uint64_t basis = 1ULL << 32;
+    quotient.assign( m - n + 1, 0 );
+    for( std::size_t j = m - n + 1; j-- > 0; ) {
+        const std::uint64_t oben = ( static_cast<std::uint64_t>( un[j + n] ) << 32 ) | un[j + n - 1];
+        std::uint64_t qDach = oben / vn[n - 1];
+        std::uint64_t rDach = oben - qDach * vn[n - 1];
+        while( qDach >= basis || qDach * vn[n - 2] > ( ( rDach << 32 ) | un[j + n - 2] ) ) {
+            qDach--;
+            rDach += vn[n - 1];
+            if( rDach >= basis )
+                break;
+        }
+        ///Multiplizieren und subtrahieren
+        std::int64_t borgen = 0;
+        std::int64_t t;
+        for( std::size_t i = 0; i < n; i++ ) {
+            const std::uint64_t p = qDach * vn[i];
+            t = static_cast<std::int64_t>( un[i + j] ) - borgen - static_cast<std::int64_t>( p & 0xFFFFFFFF );
+            un[i + j] = static_cast<std::uint32_t>( t );
+            borgen = static_cast<std::int64_t>( p >> 32 ) - ( t >> 32 );
+        }
+        t = static_cast<std::int64_t>( un[j + n] ) - borgen;
+        un[j + n] = static_cast<std::uint32_t>( t );
+        quotient[j] = static_cast<std::uint32_t>( qDach );
+        ///Die Schätzung war um eins zu groß, v wird wieder addiert.
+        if( t < 0 ) {
+            quotient[j]--;
+            std::uint64_t uebertrag = 0;
+            for( std::size_t i = 0; i < n; i++ ) {
+                uebertrag += static_cast<std::uint64_t>( un[i + j] ) + vn[i];
+                un[i + j] = static_cast<std::uint32_t>( uebertrag );
+                uebertrag >>= 32;
+            }
+            un[j + n] += static_cast<std::uint32_t>( uebertrag );
+        }
+    }
+    entferneNullen( quotient );
+    ///Den Rest zurück verschieben
+    rest.resize( n );
+    for( std::size_t i = 0; i < n; i++ )
+        rest[i] = ( un[i] >> s ) | static_cast<std::uint32_t>( static_cast<std::uint64_t>( un[i + 1] ) << ( 32 - s ) );
+    entferneNullen( rest );
+}
+
+/**
+    @brief Gibt die Anzahl der Nullbits am unteren Ende zurück.
+    @pre a ist nicht 0
+ */
+static std::size_t endnullen( const Ziffern& a ) {
+    std::size_t i = 0;
+    while( a[i] == 0 )
+        i++;
+    return 32 * i + zaehleEndnullen( a[i] );
+}
+
+/**
+    @brief Verschiebt a um bits nach rechts.
+ */
+static void schiebeRechts( Ziffern& a, std::size_t bits ) {
+    const std::size_t ganze = bits / 32;
+    const int teil = bits % 32;
+    if( ganze >= a.size() ) {
+        a.clear();
+        return;
+    }
+    a.erase( a.begin(), a.begin() + ganze );
+    if( teil != 0 ) {
+        for( std::size_t i = 0; i + 1 < a.size(); i++ )
+            a[i] = ( a[i] >> teil ) | ( a[i + 1] << ( 32 - teil ) );
+        a.back() >>= teil;
+    }
+    entferneNullen( a );
+}
+
+/**
+    @brief Verschiebt a um bits nach links.
+ */
+static void schiebeLinks( Ziffern& a, std::size_t bits ) {
+    if( a.empty() )
+        return;
+    const std::size_t ganze = bits / 32;
+    const int teil = bits % 32;
+    if( teil != 0 ) {
+        a.push_back( 0 );
+        for( std::size_t i = a.size() - 1; i > 0; i-- )
+            a[i] = ( a[i] << teil ) | ( a[i - 1] >> ( 32 - teil ) );
+        a[0] <<= teil;
+        entferneNullen( a );
+    }
+    a.insert( a.begin(), ganze, 0 );
+}
+
+/**
+    @brief Setzt zwei Ziffern zu einem 64-Bit-Betrag zusammen.
+    @pre a hat höchstens zwei Ziffern
+ */
+static std::uint64_t alsKlein( const Ziffern& a ) {
+    std::uint64_t betrag = 0;
+    for( std::size_t i = a.size(); i-- > 0; )
+        betrag = ( betrag << 32 ) | a[i];
+    return betrag;
+}
+
+///Langzahl
+Ziffern Langzahl::betragZiffern() const {
+    if( istKlein() )
+        return alsZiffern( klein );
+    return gross;
+}
+
+void Langzahl::setzeBetrag( Ziffern&& ziffern ) {
+    entferneNullen( ziffern );
+    if( ziffern.size() <= 2 ) {
+        klein = alsKlein( ziffern );
+        gross.clear();
+    } else
+        gross = std::move( ziffern );
+    if( istKlein() && klein == 0 )
+        negativ = false;
+}
+
+int Langzahl::vergleicheBetrag( const Langzahl& a, const Langzahl& b ) {
+    if( a.istKlein() && b.istKlein() )
+        return a.klein < b.klein ? -1 : ( a.klein > b.klein ? 1 : 0 );
+    if( a.istKlein() )
+        return -1;
+    if( b.istKlein() )
+        return 1;
+    return vergleiche( a.gross, b.gross );
+}
+
+Langzahl Langzahl::addiere( const Langzahl& a, const Langzahl& b, bool bNegativ ) {
+    Langzahl ergebnis;
+    if( a.negativ == bNegativ ) {
+        ///Gleiche Vorzeichen: Die Beträge werden addiert.
+        ergebnis.negativ = a.negativ;
+        if( a.istKlein() && b.istKlein() && !__builtin_add_overflow( a.klein, b.klein, &ergebnis.klein ) )
+            return ergebnis;
+        ergebnis.setzeBetrag( addiereBetrag( a.betragZiffern(), b.betragZiffern() ) );
+        return ergebnis;
+    }
+    ///Unterschiedliche Vorzeichen: Der kleinere Betrag wird vom größeren abgezogen, das Vorzeichen des größeren bleibt.
+    const int vergleich = vergleicheBetrag( a, b );
+    if( vergleich == 0 )
+        return ergebnis;
+    const Langzahl& groesser = vergleich > 0 ? a : b;
+    const Langzahl& kleiner = vergleich > 0 ? b : a;
+    ergebnis.negativ = vergleich > 0 ? a.negativ : bNegativ;
+    if( groesser.istKlein() ) {
+        ergebnis.klein = groesser.klein - kleiner.klein;
+        return ergebnis;
+    }
+    Ziffern betrag = groesser.gross;
+    subtrahiereBetrag( betrag, kleiner.betragZiffern() );
+    ergebnis.setzeBetrag( std::move( betrag ) );
+    return ergebnis;
+}
+
+void Langzahl::dividiere( const Langzahl& a, const Langzahl& b, Langzahl* quotient, Langzahl* rest ) {
+    Langzahl q, r;
+    if( a.istKlein() && b.istKlein() ) {
+        q.klein = a.klein / b.klein;
+        r.klein = a.klein % b.klein;
+    } else if( vergleicheBetrag( a, b ) < 0 ) {
+        r = a;
+        r.negativ = false;
+    } else if( b.istKlein() && ( b.klein >> 32 ) == 0 ) {
+        Ziffern betrag = a.gross;
+        r.klein = dividiereDurchZiffer( betrag, static_cast<std::uint32_t>( b.klein ) );
+        q.setzeBetrag( std::move( betrag ) );
+    } else {
+        Ziffern qZiffern, rZiffern;
+        dividiereBetrag( a.betragZiffern(), b.betragZiffern(), qZiffern, rZiffern );
+        q.setzeBetrag( std::move( qZiffern ) );
+        r.setzeBetrag( std::move( rZiffern ) );
+    }
+    ///Wie bei eingebauten Ganzzahlen: Der Quotient wird zur 0 gerundet, der Rest hat das Vorzeichen des Dividenden.
+    q.negativ = ( a.negativ != b.negativ ) && q != 0;
+    r.negativ = a.negativ && r != 0;
+    if( quotient )
+        *quotient = std::move( q );
+    if( rest )
+        *rest = std::move( r );
+}
+
+Langzahl operator + ( const Langzahl& a, const Langzahl& b ) {
+    return Langzahl::addiere( a, b, b.negativ );
+}
+
+Langzahl operator - ( const Langzahl& a, const Langzahl& b ) {
+    return Langzahl::addiere( a, b, !b.negativ && b != 0 );
+}
+
+Langzahl operator * ( const Langzahl& a, const Langzahl& b ) {
+    Langzahl ergebnis;
+    if( a.istKlein() && b.istKlein() ) {
+        const unsigned __int128 produkt = static_cast<unsigned __int128>( a.klein ) * b.klein;
+        if( ( produkt >> 64 ) == 0 )
+            ergebnis.klein = static_cast<std::uint64_t>( produkt );
+        else
+            ergebnis.setzeBetrag( Ziffern{ static_cast<std::uint32_t>( produkt ), static_cast<std::uint32_t>( produkt >> 32 ),
+                                           static_cast<std::uint32_t>( produkt >> 64 ), static_cast<std::uint32_t>( produkt >> 96 ) } );
+    } else
+        ergebnis.setzeBetrag( multipliziereBetrag( a.betragZiffern(), b.betragZiffern() ) );
+    ergebnis.negativ = ( a.negativ != b.negativ ) && ergebnis != 0;
+    return ergebnis;
+}
+
+Langzahl operator / ( const Langzahl& a, const Langzahl& b ) {
+    Langzahl quotient;
+    Langzahl::dividiere( a, b, &quotient, nullptr );
+    return quotient;
+}
+
+Langzahl operator % ( const Langzahl& a, const Langzahl& b ) {
+    Langzahl rest;
+    Langzahl::dividiere( a, b, nullptr, &rest );
+    return rest;
+}
+
+void teileMitRest( const Langzahl& a, const Langzahl& b, Langzahl& quotient, Langzahl& rest ) {
+    Langzahl::dividiere( a, b, &quotient, &rest );
+}
+
+std::uint64_t Langzahl::restModulo( std::uint64_t modul ) const {
+    std::uint64_t rest = 0;
+    if( istKlein() )
+        rest = klein < modul ? klein : klein % modul;
+    else
+        for( auto ziffer = gross.rbegin(); ziffer != gross.rend(); ++ziffer )
+            rest = static_cast<std::uint64_t>( ( ( static_cast<unsigned __int128>( rest ) << 32 ) | *ziffer ) % modul );
+    return negativ && rest != 0 ? modul - rest : rest;
+}
+
+std::uint64_t Langzahl::bitsAb( int verschiebung ) const {
+    if( istKlein() )
+        return verschiebung < 64 ? klein >> verschiebung : 0;
+    const std::size_t index = verschiebung / 32;
+    unsigned __int128 bits = 0;
+    for( std::size_t i = std::min( gross.size(), index + 3 ); i > index; i-- )
+        bits = ( bits << 32 ) | gross[i - 1];
+    return static_cast<std::uint64_t>( bits >> ( verschiebung % 32 ) );
+}
+
+Langzahl Langzahl::operator - () const {
+    Langzahl ergebnis = *this;
+    if( ergebnis != 0 )
+        ergebnis.negativ = !negativ;
+    return ergebnis;
+}
+
+Langzahl& Langzahl::operator += ( const Langzahl& b ) {
+    return *this = *this + b;
+}
+
+Langzahl& Langzahl::operator -= ( const Langzahl& b ) {
+    return *this = *this - b;
+}
+
+Langzahl& Langzahl::operator *= ( const Langzahl& b ) {
+    ///Häufigster Fall in kuerzeBruch(): Vorzeichenwechsel durch Multiplikation mit -1
+    if( b.istKlein() && b.klein == 1 ) {
+        if( b.negativ && *this != 0 )
+            negativ = !negativ;
+        return *this;
+    }
+    return *this = *this * b;
+}
+
+Langzahl& Langzahl::operator /= ( const Langzahl& b ) {
+    return *this = *this / b;
+}
+
+Langzahl& Langzahl::operator %= ( const Langzahl& b ) {
+    return *this = *this % b;
+}
+
+bool operator == ( const Langzahl& a, const Langzahl& b ) {
+    return a.negativ == b.negativ && Langzahl::vergleicheBetrag( a, b ) == 0;
+}
+
+bool operator != ( const Langzahl& a, const Langzahl& b ) {
+    return !( a == b );
+}
+
+bool operator < ( const Langzahl& a, const Langzahl& b ) {
+    if( a.negativ != b.negativ )
+        return a.negativ;
+    const int vergleich = Langzahl::vergleicheBetrag( a, b );
+    return a.negativ ? vergleich > 0 : vergleich < 0;
+}
+
+bool operator > ( const Langzahl& a, const Langzahl& b ) {
+    return b < a;
+}
+
+bool operator <= ( const Langzahl& a, const Langzahl& b ) {
+    return !( b < a );
+}
+
+bool operator >= ( const Langzahl& a, const Langzahl& b ) {
+    return !( a < b );
+}
+
+std::size_t Langzahl::maximaleStellen() const {
+    ///Jede 32-Bit-Ziffer hat höchstens 10 Dezimalstellen, dazu kommt das Vorzeichen.
+    return istKlein() ? 21 : 10 * gross.size() + 1;
+}
+
+std::to_chars_result Langzahl::schreibeDezimal( char* anfang, char* ende ) const {
+    if( negativ ) {
+        if( anfang == ende )
+            return { ende, std::errc::value_too_large };
+        *anfang++ = '-';
+    }
+    if( istKlein() )
+        return std::to_chars( anfang, ende, klein );
+    ///Der Betrag wird in Blöcken von 9 Dezimalstellen von hinten nach vorne zerlegt.
+    Ziffern rest = gross;
+    std::vector<std::uint32_t> bloecke;
+    while( !rest.empty() )
+        bloecke.push_back( dividiereDurchZiffer( rest, 1000000000 ) );
+    auto ergebnis = std::to_chars( anfang, ende, bloecke.back() );
+    for( std::size_t i = bloecke.size() - 1; i-- > 0 && ergebnis.ec == std::errc(); ) {
+        if( ende - ergebnis.ptr < 9 )
+            return { ende, std::errc::value_too_large };
+        ///Blöcke nach dem ersten werden mit führenden Nullen auf 9 Stellen aufgefüllt.
+        std::uint32_t block = bloecke[i];
+        for( int stelle = 8; stelle >= 0; stelle-- ) {
+            ergebnis.ptr[stelle] = static_cast<char>( '0' + block % 10 );
+            block /= 10;
+        }
+        ergebnis.ptr += 9;
+    }
+    return ergebnis;
+}
+
+std::ostream& operator << ( std::ostream& os, const Langzahl& zahl ) {
+    std::string text( zahl.maximaleStellen(), '\0' );
+    const auto ergebnis = zahl.schreibeDezimal( text.data(), text.data() + text.size() );
+    return os.write( text.data(), ergebnis.ptr - text.data() );
+}
+
+std::istream& operator >> ( std::istream& is, Langzahl& zahl ) {
+    std::istream::sentry wache( is );
+    if( !wache )
+        return is;
+    bool negativ = false;
+    if( is.peek() == '-' || is.peek() == '+' )
+        negativ = is.get() == '-';
+    ///Solange der Wert in 64 Bit passt, wird ohne Ziffernfolge gerechnet.
+    std::uint64_t klein = 0;
+    Ziffern gross;
+    bool ziffernGefunden = false;
+    while( is.peek() >= '0' && is.peek() <= '9' ) {
+        const std::uint32_t ziffer = is.get() - '0';
+        ziffernGefunden = true;
+        std::uint64_t naechster;
+        if( gross.empty() && !__builtin_mul_overflow( klein, 10, &naechster ) && !__builtin_add_overflow( naechster, ziffer, &naechster ) ) {
+            klein = naechster;
+            continue;
+        }
+        ///Ab der ersten Ziffer, die nicht mehr in 64 Bit passt, wird auf der Ziffernfolge weitergerechnet.
+        if( gross.empty() )
+            gross = alsZiffern( klein );
+        multipliziereAddiere( gross, 10, ziffer );
+    }
+    if( is.peek() == std::char_traits<char>::eof() )
+        is.setstate( std::ios::eofbit );
+    if( !ziffernGefunden ) {
+        is.setstate( std::ios::failbit );
+        zahl = Langzahl();
+        return is;
+    }
+    zahl = Langzahl();
+    if( gross.empty() )
+        zahl.klein = klein;
+    else
+        zahl.setzeBetrag( std::move( gross ) );
+    zahl.negativ = negativ && zahl != 0;
+    return is;
+}
+
+Langzahl ggt( const Langzahl& a, const Langzahl& b ) {
+    if( a.istKlein() && b.istKlein() )
+        return Langzahl( ggt( a.klein, b.klein ) );
+    if( a == 0 )
+        return betrag( b );
+    if( b == 0 )
+        return betrag( a );
+    Ziffern u = a.betragZiffern();
+    Ziffern v = b.betragZiffern();
+    const std::size_t nullenU = endnullen( u );
+    const std::size_t nullenV = endnullen( v );
+    const std::size_t zweierpotenz = std::min( nullenU, nullenV );
+    schiebeRechts( u, nullenU );
+    schiebeRechts( v, nullenV );
+    ///Binärer ggT auf den Ziffernfolgen: Beide Zahlen sind ungerade, der größere Betrag wird durch die gerade Differenz ersetzt.
+    while( u.size() > 2 || v.size() > 2 ) {
+        const int vergleich = vergleiche( u, v );
+        if( vergleich == 0 )
+            break;
+        if( vergleich < 0 )
+            std::swap( u, v );
+        subtrahiereBetrag( u, v );
+        schiebeRechts( u, endnullen( u ) );
+    }
+    Ziffern teiler = u.size() > 2 ? u : alsZiffern( ggt( alsKlein( u ), alsKlein( v ) ) );
+    schiebeLinks( teiler, zweierpotenz );
+    Langzahl ergebnis;
+    ergebnis.setzeBetrag( std::move( teiler ) );
+    return ergebnis;
+}
+
+int bitbreite( const Langzahl& x ) {
+    if( x.istKlein() )
+        return bitbreite( x.klein );
+    return 32 * ( x.gross.size() - 1 ) + bitbreite( x.gross.back() );
+}
+
+std::size_t hashwert( const Langzahl& x ) {
+    if( x.istKlein() )
+        return static_cast<std::size_t>( x.negativ ? 0 - x.klein : x.klein );
+    std::uint64_t h = x.negativ ? 1 : 0;
+    for( const std::uint32_t ziffer : x.gross )
+        h = ( h ^ ziffer ) * 0x100000001b3ull;
+    return static_cast<std::size_t>( h );
+}
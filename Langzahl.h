@@ -0,0 +1,204 @@
+#ifndef LANGZAHL_H
+#define LANGZAHL_H
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include <charconv>
+
+#include "Bruch.h"
+
+/**
+    @brief Ganze Zahl beliebiger Größe.
+    Die Zahl wird als Vorzeichen und Betrag gespeichert. Solange der Betrag in 64 Bit passt, liegt er direkt im Objekt (kleine Zahl) und es wird kein Speicher angefordert.
+    Erst wenn er wächst, wird er als Folge von 32-Bit-Ziffern (niederwertigste zuerst) auf dem Heap abgelegt. Wird er wieder klein genug, wechselt er zurück in das Objekt.
+    Die Klasse stellt alle Operatoren bereit, die Bruch, kuerzeBruch() und die Ein- und Ausgabe von Brüchen brauchen, sodass Bruch<Langzahl> exakt ohne Überlauf rechnet.
+ */
+class Langzahl {
+    public:
+        using Ziffern = std::vector<std::uint32_t>;
+
+        /**
+            @brief Standardkonstruktor: Initialisiert die Zahl mit 0.
+         */
+        Langzahl()
+            : negativ( false ), klein( 0 ) {
+        }
+
+        /**
+            @brief Konstruktor: Initialisiert die Zahl mit einer eingebauten Ganzzahl.
+            Der Konstruktor ist absichtlich nicht explicit, damit z.B. "zaehler == 0" oder "Bruch<Langzahl>( 1 )" wie mit eingebauten Typen funktionieren.
+            @arg I: eingebauter Ganzzahltyp (auch __int128)
+            @param wert: Der Wert
+         */
+        template < typename I, typename std::enable_if < IstEingebauteGanzzahl<I>::value, int >::type = 0 >
+        Langzahl( I wert )
+            : negativ( wert < 0 ), klein( 0 ) {
+            using U = typename VorzeichenloseForm<I>::Typ;
+            const U betrag = negativ ? static_cast<U>( -static_cast<U>( wert ) ) : static_cast<U>( wert );
+            if constexpr( sizeof( U ) <= sizeof( std::uint64_t ) )
+                klein = betrag;
+            else {
+                if( ( betrag >> 64 ) == 0 )
+                    klein = static_cast<std::uint64_t>( betrag );
+                else
+                    setzeBetrag( Ziffern{ static_cast<std::uint32_t>( betrag ), static_cast<std::uint32_t>( betrag >> 32 ),
+                                          static_cast<std::uint32_t>( betrag >> 64 ), static_cast<std::uint32_t>( betrag >> 96 ) } );
+            }
+        }
+
+        /**
+            @brief Gibt zurück, ob der Betrag direkt im Objekt liegt (also in 64 Bit passt).
+            @returns True, wenn der Betrag kleiner als 2^64 ist
+         */
+        bool istKlein() const {
+            return gross.empty();
+        }
+
+        /**
+            @brief Gibt zurück, ob die Zahl negativ ist.
+            @returns True, wenn die Zahl kleiner als 0 ist
+         */
+        bool istNegativ() const {
+            return negativ;
+        }
+
+        /**
+            @brief Gibt den Betrag als Ziffernfolge zurück.
+            @returns Die 32-Bit-Ziffern des Betrags, niederwertigste zuerst, ohne führende Nullen
+         */
+        Ziffern betragZiffern() const;
+
+        /**
+            @brief Schreibt die Zahl im Dezimalsystem in den Bereich [anfang, ende).
+            Wie std::to_chars wird nichts angehängt (auch keine abschließende Null). Kleine Zahlen werden ohne Speicheranforderung geschrieben.
+            @param anfang: Anfang des Puffers
+            @param ende: Ende des Puffers
+            @returns Zeiger hinter das letzte geschriebene Zeichen, errc::value_too_large falls der Puffer zu klein ist
+         */
+        std::to_chars_result schreibeDezimal( char* anfang, char* ende ) const;
+
+        /**
+            @brief Gibt eine obere Schranke für die Länge der Dezimaldarstellung zurück.
+            @returns Anzahl Zeichen, die schreibeDezimal höchstens braucht
+         */
+        std::size_t maximaleStellen() const;
+
+        /**
+            @brief Gibt den Rest der Zahl modulo einer Zahl mit 64 Bit zurück.
+            Anders als der Operator % wird keine Langzahl angelegt, die Ziffern werden direkt nach Horner reduziert.
+            @param modul: Der Modul
+            @returns Rest zwischen 0 und modul - 1, auch für negative Zahlen
+            @pre modul != 0
+         */
+        std::uint64_t restModulo( std::uint64_t modul ) const;
+
+        /**
+            @brief Gibt die Bits des Betrags ab Bit verschiebung zurück.
+            @param verschiebung: Anzahl der unteren Bits, die entfallen
+            @returns Die unteren 64 Bit von |x| / 2^verschiebung
+         */
+        std::uint64_t bitsAb( int verschiebung ) const;
+
+        ///Rechenoperationen
+        friend Langzahl operator + ( const Langzahl& a, const Langzahl& b );
+        friend Langzahl operator - ( const Langzahl& a, const Langzahl& b );
+        friend Langzahl operator * ( const Langzahl& a, const Langzahl& b );
+        /**
+            @brief Dividiert die Zahlen.
+            Wie bei eingebauten Ganzzahlen wird in Richtung 0 gerundet.
+            @pre b != 0
+         */
+        friend Langzahl operator / ( const Langzahl& a, const Langzahl& b );
+        /**
+            @brief Gibt den Rest der Division zurück.
+            Wie bei eingebauten Ganzzahlen hat der Rest das Vorzeichen von a.
+            @pre b != 0
+         */
+        friend Langzahl operator % ( const Langzahl& a, const Langzahl& b );
+        /**
+            @brief Teilt a durch b und gibt Quotient und Rest in einem Schritt zurück.
+            Rundung und Vorzeichen wie bei den Operatoren / und %, es wird aber nur einmal dividiert.
+            @pre b != 0
+         */
+        friend void teileMitRest( const Langzahl& a, const Langzahl& b, Langzahl& quotient, Langzahl& rest );
+        Langzahl operator - () const;
+        Langzahl& operator += ( const Langzahl& b );
+        Langzahl& operator -= ( const Langzahl& b );
+        Langzahl& operator *= ( const Langzahl& b );
+        Langzahl& operator /= ( const Langzahl& b );
+        Langzahl& operator %= ( const Langzahl& b );
+
+        ///Vergleiche
+        friend bool operator == ( const Langzahl& a, const Langzahl& b );
+        friend bool operator != ( const Langzahl& a, const Langzahl& b );
+        friend bool operator < ( const Langzahl& a, const Langzahl& b );
+        friend bool operator > ( const Langzahl& a, const Langzahl& b );
+        friend bool operator <= ( const Langzahl& a, const Langzahl& b );
+        friend bool operator >= ( const Langzahl& a, const Langzahl& b );
+
+        ///Ein- und Ausgabe
+        friend std::ostream& operator << ( std::ostream& os, const Langzahl& zahl );
+        /**
+            @brief Liest eine Langzahl ein.
+            Der Operator verhält sich wie das Einlesen eingebauter Ganzzahlen: Führende whitespace chars werden übersprungen, danach folgen ein optionales Vorzeichen und die Ziffern.
+            Werden keine Ziffern gefunden, wird das failbit gesetzt.
+         */
+        friend std::istream& operator >> ( std::istream& is, Langzahl& zahl );
+
+        /**
+            @brief Gibt größten gemeinsamen Teiler der Zahlen zurück.
+            Sind beide Zahlen klein, wird der binäre ggT für 64 Bit genutzt. Ansonsten rechnet der binäre Algorithmus direkt auf den Ziffernfolgen und wechselt auf 64 Bit, sobald beide Zahlen klein genug sind.
+            @param a: Zahl a
+            @param b: Zahl b
+            @returns Größten gemeinsamen Teiler (immer positiv)
+         */
+        friend Langzahl ggt( const Langzahl& a, const Langzahl& b );
+
+        /**
+            @brief Gibt die Anzahl der Bits des Betrags zurück.
+            @param x: Die Zahl
+            @returns Bitbreite von |x|
+         */
+        friend int bitbreite( const Langzahl& x );
+
+        /**
+            @brief Gibt einen Hashwert der Zahl zurück, für std::hash<Bruch<Langzahl>>.
+            Kleine Zahlen haben denselben Hashwert wie die eingebaute Zahl mit demselben Wert.
+         */
+        friend std::size_t hashwert( const Langzahl& x );
+
+    private:
+        /**
+            @brief Setzt den Betrag aus einer Ziffernfolge.
+            Führende Nullen werden entfernt. Passt der Betrag in 64 Bit, wird er als kleine Zahl gespeichert. Bei Betrag 0 wird das Vorzeichen entfernt.
+            @param ziffern: Der neue Betrag
+         */
+        void setzeBetrag( Ziffern&& ziffern );
+        /**
+            @brief Vergleicht die Beträge der Zahlen.
+            @returns -1, 0 oder 1, wenn |a| kleiner, gleich oder größer als |b| ist
+         */
+        static int vergleicheBetrag( const Langzahl& a, const Langzahl& b );
+        /**
+            @brief Addiert zwei Zahlen, deren Vorzeichen vorher ggf. vertauscht wurde.
+            @param b: Zweiter Summand
+            @param bNegativ: Vorzeichen des zweiten Summanden
+         */
+        static Langzahl addiere( const Langzahl& a, const Langzahl& b, bool bNegativ );
+        /**
+            @brief Teilt a durch b mit Rest.
+            @param quotient: Ausgabe für den Quotient, darf nullptr sein
+            @param rest: Ausgabe für den Rest, darf nullptr sein
+         */
+        static void dividiere( const Langzahl& a, const Langzahl& b, Langzahl* quotient, Langzahl* rest );
+
+        bool negativ;
+        ///Betrag, solange gross leer ist
+        std::uint64_t klein;
+        ///Betrag ab 2^64, sonst leer
+        Ziffern gross;
+};
+
+#endif // LANGZAHL_H
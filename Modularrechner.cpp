@@ -0,0 +1,455 @@
+#include "Modularrechner.h"
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "Bruchberechner.h"
+#include "Termprogramm.h"
+
+///Rechnen modulo p, alle Reste liegen zwischen 0 und p - 1 < 2^62.
+static std::uint64_t addiereModulo( std::uint64_t a, std::uint64_t b, std::uint64_t p ) {
+    const std::uint64_t summe = a + b;
+    return summe >= p ? summe - p : summe;
+}
+static std::uint64_t multipliziereModulo( std::uint64_t a, std::uint64_t b, std::uint64_t p ) {
+    return static_cast<std::uint64_t>( static_cast<unsigned __int128>( a ) * b % p );
+}
+static std::uint64_t potenziereModulo( std::uint64_t basis, std::uint64_t exponent, std::uint64_t p ) {
+    std::uint64_t ergebnis = 1;
+    for( basis %= p; exponent != 0; exponent >>= 1 ) {
+        if( exponent & 1 )
+            ergebnis = multipliziereModulo( ergebnis, basis, p );
+        basis = multipliziereModulo( basis, basis, p );
+    }
+    return ergebnis;
+}
+/**
+    @brief Gibt das Inverse von a modulo der Primzahl p zurück.
+    @pre a != 0
+ */
+static std::uint64_t invertiereModulo( std::uint64_t a, std::uint64_t p ) {
+    return potenziereModulo( a, p - 2, p );
+}
+
+/**
+    @brief Prüft mit dem deterministischen Miller-Rabin-Test für 64 Bit, ob n eine Primzahl ist.
+ */
+static bool istPrimzahl( std::uint64_t n ) {
+    if( n < 2 || n % 2 == 0 )
+        return n == 2;
+    std::uint64_t d = n - 1;
+    int s = 0;
+    while( d % 2 == 0 ) {
+        d /= 2;
+        s++;
+    }
+    ///Diese Basen entscheiden den Test für alle n < 2^64 (Sinclair).
+    for( std::uint64_t basis : { 2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull } ) {
+        std::uint64_t x = potenziereModulo( basis, d, n );
+        if( x == 0 || x == 1 || x == n - 1 )
+            continue;
+        bool zusammengesetzt = true;
+        for( int i = 1; i < s && zusammengesetzt; i++ ) {
+            x = multipliziereModulo( x, x, n );
+            zusammengesetzt = x != n - 1;
+        }
+        if( zusammengesetzt )
+            return false;
+    }
+    return true;
+}
+
+std::uint64_t getModularPrimzahl( std::size_t i ) {
+    static std::mutex sperre;
+    static std::vector<std::uint64_t> primzahlen;
+    std::lock_guard<std::mutex> wache( sperre );
+    while( primzahlen.size() <= i ) {
+        std::uint64_t kandidat = primzahlen.empty() ? ( 1ull << 62 ) - 1 : primzahlen.back() - 2;
+        while( !istPrimzahl( kandidat ) )
+            kandidat -= 2;
+        primzahlen.push_back( kandidat );
+    }
+    return primzahlen[i];
+}
+
+/**
+    @brief Führt mehrere Schritte des erweiterten Euklidischen Algorithmus auf einmal aus (Lehmer, Knuth TAOCP Bd. 2, 4.5.2 Algorithmus L).
+    Die Quotienten werden aus den oberen 62 Bit von r0 und r1 bestimmt, solange sie sicher mit denen der vollen Zahlen übereinstimmen.
+    Die gesammelten Schritte werden dann als 2x2-Matrix mit kleinen Einträgen auf r0, r1, t0 und t1 angewandt. So wird statt einer Langzahl-Division je Schritt
+    nur alle etwa 30 Schritte mit Zahlen bis 64 Bit multipliziert.
+    @returns False, wenn kein Schritt sicher bestimmt werden konnte, dann muss einmal voll dividiert werden
+ */
+static bool lehmerSchritt( Langzahl& r0, Langzahl& r1, Langzahl& t0, Langzahl& t1 ) {
+    const int verschiebung = std::max( 0, bitbreite( r0 ) - 62 );
+    std::int64_t a = static_cast<std::int64_t>( r0.bitsAb( verschiebung ) );
+    std::int64_t b = static_cast<std::int64_t>( r1.bitsAb( verschiebung ) );
+    std::int64_t A = 1, B = 0, C = 0, D = 1;
+    while( b + C != 0 && b + D != 0 ) {
+        const std::int64_t q = ( a + A ) / ( b + C );
+        if( q != ( a + B ) / ( b + D ) )
+            break;
+        std::int64_t t = A - q * C;
+        A = C;
+        C = t;
+        t = B - q * D;
+        B = D;
+        D = t;
+        t = a - q * b;
+        a = b;
+        b = t;
+    }
+    if( B == 0 )
+        return false;
+    Langzahl neu0 = Langzahl( A ) * r0 + Langzahl( B ) * r1;
+    r1 = Langzahl( C ) * r0 + Langzahl( D ) * r1;
+    r0 = std::move( neu0 );
+    Langzahl neuT0 = Langzahl( A ) * t0 + Langzahl( B ) * t1;
+    t1 = Langzahl( C ) * t0 + Langzahl( D ) * t1;
+    t0 = std::move( neuT0 );
+    return true;
+}
+
+bool rekonstruiereBruch( const Langzahl& x, const Langzahl& modul, Bruch<Langzahl>& ergebnis ) {
+    ///Zähler und Nenner müssen kleiner als 2^grenze sein, dann ist 2 * z * n < 2^( 2 * grenze + 1 ) <= modul.
+    const int grenze = ( bitbreite( modul ) - 1 ) / 2;
+    Langzahl r0 = modul, r1 = x;
+    Langzahl t0 = 0, t1 = 1;
+    Langzahl quotient, rest;
+    while( bitbreite( r1 ) > grenze ) {
+        ///Weit vor dem Ende wird mit Lehmer gerechnet. Überspringt ein Lehmer-Schritt den ersten Rest unter der Grenze, wird er verworfen und einzeln weitergerechnet.
+        if( bitbreite( r1 ) > grenze + 64 ) {
+            Langzahl sicherung[] = { r0, r1, t0, t1 };
+            if( lehmerSchritt( r0, r1, t0, t1 ) ) {
+                if( bitbreite( r1 ) > grenze )
+                    continue;
+                r0 = std::move( sicherung[0] );
+                r1 = std::move( sicherung[1] );
+                t0 = std::move( sicherung[2] );
+                t1 = std::move( sicherung[3] );
+            }
+        }
+        teileMitRest( r0, r1, quotient, rest );
+        r0 = std::move( r1 );
+        r1 = std::move( rest );
+        Langzahl t = t0 - quotient * t1;
+        t0 = std::move( t1 );
+        t1 = std::move( t );
+    }
+    if( t1 == 0 || bitbreite( t1 ) > grenze || ggt( r1, t1 ) != 1 )
+        return false;
+    ergebnis = Bruch<Langzahl>( t1, r1 );
+    ergebnis.kuerzeBruch();
+    return true;
+}
+
+/**
+    @brief Zähler und Nenner einer Zahl des Terms.
+    Sie werden einmal aus dem Programm kopiert, getZaehler und getNenner würden für jede Primzahl eine Kopie der Langzahl anlegen.
+    Passen beide Beträge in 62 Bit, ist der Rest modulo p > 2^61 mit einer Subtraktion bestimmt und restModulo wird nicht gebraucht.
+ */
+struct ModularKonstante {
+    ModularKonstante( const Langzahl& zaehler, const Langzahl& nenner )
+        : zaehler( zaehler ), nenner( nenner ), klein( bitbreite( zaehler ) <= 62 && bitbreite( nenner ) <= 62 ),
+          betragZaehler( zaehler.bitsAb( 0 ) ), betragNenner( nenner.bitsAb( 0 ) ) {}
+
+    ///Gibt den Rest des Betrags v < 2^62 modulo p zurück, negiert falls negativ = true.
+    static std::uint64_t rest( std::uint64_t v, bool negativ, std::uint64_t p ) {
+        const std::uint64_t r = v >= p ? v - p : v;
+        return negativ && r != 0 ? p - r : r;
+    }
+    std::uint64_t zaehlerModulo( std::uint64_t p ) const {
+        return klein ? rest( betragZaehler, zaehler.istNegativ(), p ) : zaehler.restModulo( p );
+    }
+    std::uint64_t nennerModulo( std::uint64_t p ) const {
+        return klein ? rest( betragNenner, nenner.istNegativ(), p ) : nenner.restModulo( p );
+    }
+
+    Langzahl zaehler;
+    Langzahl nenner;
+    bool klein;
+    std::uint64_t betragZaehler;
+    std::uint64_t betragNenner;
+};
+
+/**
+    @brief Rechnet modulo einer Primzahl p < 2^62 in Montgomery-Darstellung.
+    Ein Rest a wird als a * 2^64 mod p gespeichert. Das Produkt zweier Reste wird dann mit zwei Multiplikationen und einer Verschiebung reduziert (Montgomery, 1985)
+    statt mit einer 128-Bit-Division, die der Compiler als Aufruf einer Bibliotheksfunktion übersetzt.
+ */
+class Montgomery {
+    public:
+        explicit Montgomery( std::uint64_t p )
+            : p( p ) {
+            ///Newton-Iteration für p^-1 modulo 2^64, jeder Schritt verdoppelt die Zahl der richtigen Bits.
+            std::uint64_t inverses = p;
+            for( int i = 0; i < 5; i++ )
+                inverses *= 2 - p * inverses;
+            negativesInverses = -inverses;
+            const std::uint64_t r = static_cast<std::uint64_t>( ( static_cast<unsigned __int128>( 1 ) << 64 ) % p );
+            rQuadrat = multipliziereModulo( r, r, p );
+        }
+
+        std::uint64_t hinein( std::uint64_t a ) const {
+            return multipliziere( a, rQuadrat );
+        }
+        std::uint64_t heraus( std::uint64_t a ) const {
+            return reduziere( a );
+        }
+        std::uint64_t multipliziere( std::uint64_t a, std::uint64_t b ) const {
+            return reduziere( static_cast<unsigned __int128>( a ) * b );
+        }
+        std::uint64_t addiere( std::uint64_t a, std::uint64_t b ) const {
+            return addiereModulo( a, b, p );
+        }
+        std::uint64_t negiere( std::uint64_t a ) const {
+            return a == 0 ? 0 : p - a;
+        }
+
+    private:
+        ///Gibt t * 2^-64 mod p zurück, für t < p * 2^64.
+        std::uint64_t reduziere( unsigned __int128 t ) const {
+            const std::uint64_t m = static_cast<std::uint64_t>( t ) * negativesInverses;
+            const std::uint64_t ergebnis = static_cast<std::uint64_t>( ( t + static_cast<unsigned __int128>( m ) * p ) >> 64 );
+            return ergebnis >= p ? ergebnis - p : ergebnis;
+        }
+
+        std::uint64_t p;
+        std::uint64_t negativesInverses;
+        std::uint64_t rQuadrat;
+};
+
+/**
+    @brief Berechnet das übersetzte Programm modulo p.
+    Jede Zahl wird als Paar aus Zähler und Nenner modulo p geführt, sodass nie invertiert werden muss. Erst am Ende wird durch den Nenner geteilt.
+    @param stapel: Arbeitsspeicher für den Stapel, wird bei Bedarf vergrößert
+    @param rest: Das Ergebnis modulo p
+    @returns False, wenn p den Nenner teilt (oder durch 0 geteilt wird), dann ist die Primzahl unbrauchbar
+ */
+static bool berechneRest( const Termprogramm<Langzahl>& programm, const std::vector<ModularKonstante>& konstanten, std::uint64_t p,
+                          std::vector<std::pair<std::uint64_t, std::uint64_t>>& stapel, std::uint64_t& rest ) {
+    const Montgomery m( p );
+    auto addiere = [&m]( std::pair<std::uint64_t, std::uint64_t> a, std::pair<std::uint64_t, std::uint64_t> b ) {
+        return std::make_pair( m.addiere( m.multipliziere( a.first, b.second ), m.multipliziere( b.first, a.second ) ), m.multipliziere( a.second, b.second ) );
+    };
+    auto multipliziere = [&m]( std::pair<std::uint64_t, std::uint64_t> a, std::pair<std::uint64_t, std::uint64_t> b ) {
+        return std::make_pair( m.multipliziere( a.first, b.first ), m.multipliziere( a.second, b.second ) );
+    };
+    stapel.resize( std::max<std::size_t>( stapel.size(), programm.getStapeltiefe() ) );
+    auto* spitze = stapel.data();
+    for( const auto& a : programm.getAnweisungen() ) {
+        switch( a.befehl ) {
+            case Befehl::Konstante:
+                *spitze++ = { m.hinein( konstanten[a.index].zaehlerModulo( p ) ), m.hinein( konstanten[a.index].nennerModulo( p ) ) };
+                break;
+            case Befehl::Addition:
+                spitze--;
+                spitze[-1] = addiere( spitze[-1], spitze[0] );
+                break;
+            case Befehl::Subtraktion:
+                spitze--;
+                spitze[-1] = addiere( spitze[-1], { m.negiere( spitze[0].first ), spitze[0].second } );
+                break;
+            case Befehl::Multiplikation:
+                spitze--;
+                spitze[-1] = multipliziere( spitze[-1], spitze[0] );
+                break;
+            case Befehl::Division:
+                spitze--;
+                ///Ein Nenner 0 des Divisors ginge durch das Vertauschen verloren, wenn sein Zähler später mit 0 multipliziert wird.
+                if( spitze[0].first == 0 || spitze[0].second == 0 || spitze[-1].second == 0 )
+                    return false;
+                spitze[-1] = multipliziere( spitze[-1], { spitze[0].second, spitze[0].first } );
+                break;
+            case Befehl::Variable:
+            case Befehl::Kuerzen:
+                ///Das Programm wird ohne Variablen übersetzt, und gekürzt wird erst bei der Rekonstruktion.
+                break;
+            case Befehl::Summe:
+            case Befehl::Produkt: {
+                spitze -= a.index;
+                std::pair<std::uint64_t, std::uint64_t> ergebnis = { m.hinein( a.befehl == Befehl::Summe ? 0 : 1 ), m.hinein( 1 ) };
+                for( std::uint32_t i = 0; i < a.index; i++ )
+                    ergebnis = a.befehl == Befehl::Summe ? addiere( ergebnis, spitze[i] ) : multipliziere( ergebnis, spitze[i] );
+                *spitze++ = ergebnis;
+                break;
+            }
+        }
+    }
+    const std::uint64_t zaehler = m.heraus( stapel[0].first );
+    const std::uint64_t nenner = m.heraus( stapel[0].second );
+    if( nenner == 0 )
+        return false;
+    rest = multipliziereModulo( zaehler, invertiereModulo( nenner, p ), p );
+    return true;
+}
+
+/**
+    @brief Bestimmt eine obere Schranke für die Bitbreite von |Zähler| und Nenner des ungekürzten Ergebnisses.
+    Für a/b + c/d gilt |ad + cb| < 2^( max( a + d, c + b ) + 1 ) in Bits, für Produkt und Quotient addieren sich die Bitbreiten.
+    @returns Die größere der Schranken für Zähler und Nenner
+ */
+static std::size_t bestimmeSchranke( const Termprogramm<Langzahl>& programm ) {
+    std::vector<std::pair<std::size_t, std::size_t>> stapel( programm.getStapeltiefe() );
+    auto* spitze = stapel.data();
+    auto addiere = []( std::pair<std::size_t, std::size_t> a, std::pair<std::size_t, std::size_t> b ) {
+        return std::make_pair( std::max( a.first + b.second, b.first + a.second ) + 1, a.second + b.second );
+    };
+    auto multipliziere = []( std::pair<std::size_t, std::size_t> a, std::pair<std::size_t, std::size_t> b ) {
+        return std::make_pair( a.first + b.first, a.second + b.second );
+    };
+    for( const auto& a : programm.getAnweisungen() ) {
+        switch( a.befehl ) {
+            case Befehl::Konstante: {
+                const auto& b = programm.getKonstanten()[a.index];
+                *spitze++ = { bitbreite( b.getZaehler() ), bitbreite( b.getNenner() ) };
+                break;
+            }
+            case Befehl::Addition:
+            case Befehl::Subtraktion:
+                spitze--;
+                spitze[-1] = addiere( spitze[-1], spitze[0] );
+                break;
+            case Befehl::Multiplikation:
+                spitze--;
+                spitze[-1] = multipliziere( spitze[-1], spitze[0] );
+                break;
+            case Befehl::Division:
+                spitze--;
+                spitze[-1] = multipliziere( spitze[-1], { spitze[0].second, spitze[0].first } );
+                break;
+            case Befehl::Summe:
+            case Befehl::Produkt: {
+                spitze -= a.index;
+                std::pair<std::size_t, std::size_t> ergebnis = { a.befehl == Befehl::Summe ? 0 : 1, 1 };
+                for( std::uint32_t i = 0; i < a.index; i++ )
+                    ergebnis = a.befehl == Befehl::Summe ? addiere( ergebnis, spitze[i] ) : multipliziere( ergebnis, spitze[i] );
+                *spitze++ = ergebnis;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return std::max( stapel[0].first, stapel[0].second );
+}
+
+/**
+    @brief Berechnet das Programm für die Primzahlen [erste, erste + anzahl), auf pool verteilt oder ohne Threads, falls pool nullptr ist.
+    @param reste: Je Primzahl der Rest, gueltig[i] = false für unbrauchbare Primzahlen
+ */
+static void berechneReste( const Termprogramm<Langzahl>& programm, const std::vector<ModularKonstante>& konstanten, std::size_t erste, std::size_t anzahl,
+                           Arbeitspool* pool, std::vector<std::uint64_t>& reste, std::vector<char>& gueltig ) {
+    reste.assign( anzahl, 0 );
+    gueltig.assign( anzahl, 0 );
+    auto berechneAbschnitt = [&]( std::size_t von, std::size_t bis ) {
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> stapel;
+        for( std::size_t i = von; i < bis; i++ )
+            gueltig[i] = berechneRest( programm, konstanten, getModularPrimzahl( erste + i ), stapel, reste[i] );
+    };
+    if( pool == nullptr || anzahl == 1 ) {
+        berechneAbschnitt( 0, anzahl );
+        return;
+    }
+    ///Eine Aufgabe je Thread, die Primzahlen eines Durchgangs sind gleich teuer.
+    const std::size_t aufgaben = std::min<std::size_t>( anzahl, pool->getAnzahlThreads() );
+    std::atomic<std::size_t> offen( aufgaben );
+    for( std::size_t t = 0; t < aufgaben; t++ )
+        pool->fuegeHinzu( [&, t]() {
+            berechneAbschnitt( anzahl * t / aufgaben, anzahl * ( t + 1 ) / aufgaben );
+            offen.fetch_sub( 1, std::memory_order_release );
+        } );
+    while( offen.load( std::memory_order_acquire ) != 0 )
+        if( !pool->fuehreEineAus() )
+            std::this_thread::yield();
+}
+
+/**
+    @brief Gemeinsamer Ablauf für beide Varianten von berechneTermModular.
+ */
+static Bruch<Langzahl> berechneModular( std::string_view term, Arbeitspool* pool, Modularbericht* bericht ) {
+    Modularbericht verlauf;
+    auto rueckfall = [&]() {
+        verlauf.rueckfall = true;
+        if( bericht )
+            *bericht = verlauf;
+        return berechneNaechstenTerm<Langzahl>( term );
+    };
+    const Termprogramm<Langzahl> programm( term );
+    std::vector<ModularKonstante> konstanten;
+    for( const auto& b : programm.getKonstanten() )
+        konstanten.emplace_back( b.getZaehler(), b.getNenner() );
+    verlauf.schranke = bestimmeSchranke( programm );
+    ///Ab dieser Bitbreite des Moduls ist das Ergebnis durch die Schranke eindeutig bestimmt (2 * z^2 < modul und 2 * n^2 < modul).
+    const std::size_t benoetigt = 2 * verlauf.schranke + 2;
+    Langzahl x = 0, modul = 1;
+    Bruch<Langzahl> kandidat;
+    bool hatKandidat = false;
+    std::size_t naechste = 0;
+    std::size_t durchgang = pool ? pool->getAnzahlThreads() : 1;
+    std::vector<std::uint64_t> reste;
+    std::vector<char> gueltig;
+    for( ;; ) {
+        ///Mehr Primzahlen, als bis zur Schranke fehlen, werden nicht gebraucht. Zur Prüfung eines Kandidaten genügt eine Primzahl je Thread.
+        const std::size_t fehlend = ( benoetigt - std::min<std::size_t>( benoetigt, bitbreite( modul ) ) ) / 61 + 1;
+        const std::size_t pruefung = pool ? pool->getAnzahlThreads() : 1;
+        const std::size_t anzahl = std::min( hatKandidat ? pruefung : durchgang, fehlend );
+        berechneReste( programm, konstanten, naechste, anzahl, pool, reste, gueltig );
+        naechste += anzahl;
+        if( std::count( gueltig.begin(), gueltig.end(), 1 ) == 0 )
+            return rueckfall();
+        ///Prüfung: Der vorzeitig rekonstruierte Bruch muss auch zu den neuen Resten passen, die nicht in ihn eingegangen sind.
+        if( hatKandidat ) {
+            bool passt = true;
+            for( std::size_t i = 0; i < anzahl && passt; i++ ) {
+                const std::uint64_t p = getModularPrimzahl( naechste - anzahl + i );
+                if( gueltig[i] )
+                    passt = kandidat.getZaehler().restModulo( p ) == multipliziereModulo( reste[i], kandidat.getNenner().restModulo( p ), p );
+            }
+            if( passt ) {
+                verlauf.vorzeitig = true;
+                if( bericht )
+                    *bericht = verlauf;
+                return kandidat;
+            }
+            hatKandidat = false;
+        }
+        ///Garner: x wird so um ein Vielfaches von modul erhöht, dass es auch modulo p stimmt.
+        for( std::size_t i = 0; i < anzahl; i++ ) {
+            if( !gueltig[i] ) {
+                verlauf.unbrauchbar++;
+                continue;
+            }
+            const std::uint64_t p = getModularPrimzahl( naechste - anzahl + i );
+            const std::uint64_t differenz = ( reste[i] + p - x.restModulo( p ) ) % p;
+            const std::uint64_t faktor = multipliziereModulo( differenz, invertiereModulo( modul.restModulo( p ), p ), p );
+            x += modul * Langzahl( faktor );
+            modul *= Langzahl( p );
+            verlauf.primzahlen++;
+        }
+        if( static_cast<std::size_t>( bitbreite( modul ) ) > benoetigt ) {
+            Bruch<Langzahl> ergebnis;
+            if( !rekonstruiereBruch( x, modul, ergebnis ) )
+                return rueckfall();
+            if( bericht )
+                *bericht = verlauf;
+            return ergebnis;
+        }
+        hatKandidat = rekonstruiereBruch( x, modul, kandidat );
+        ///Die Zahl der Primzahlen je Durchgang verdoppelt sich, damit die Rekonstruktionen zusammen nicht mehr kosten als die letzte.
+        durchgang = std::max( durchgang, verlauf.primzahlen );
+    }
+}
+
+Bruch<Langzahl> berechneTermModular( std::string_view term, Arbeitspool& pool, Modularbericht* bericht ) {
+    return berechneModular( term, &pool, bericht );
+}
+
+Bruch<Langzahl> berechneTermModular( std::string_view term, unsigned threads, Modularbericht* bericht ) {
+    if( threads == 1 )
+        return berechneModular( term, nullptr, bericht );
+    Arbeitspool pool( threads );
+    return berechneModular( term, &pool, bericht );
+}
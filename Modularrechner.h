@@ -0,0 +1,67 @@
+#ifndef MODULARRECHNER_H
+#define MODULARRECHNER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "Bruch.h"
+#include "Langzahl.h"
+#include "Arbeitspool.h"
+
+/**
+    @brief Angaben zum Verlauf einer modularen Berechnung.
+ */
+struct Modularbericht {
+    ///Anzahl der Primzahlen, deren Reste in das Ergebnis eingegangen sind
+    std::size_t primzahlen = 0;
+    ///Primzahlen, die den Nenner teilen und deshalb übersprungen wurden
+    std::size_t unbrauchbar = 0;
+    ///Obere Schranke für die Bitbreite von Zähler und Nenner des ungekürzten Ergebnisses
+    std::size_t schranke = 0;
+    ///True, wenn das Ergebnis schon vor Erreichen der Schranke durch zusätzliche Primzahlen bestätigt wurde
+    bool vorzeitig = false;
+    ///True, wenn auf die exakte Berechnung mit Bruch<Langzahl> zurückgegriffen wurde
+    bool rueckfall = false;
+};
+
+/**
+    @brief Gibt die i-te Primzahl der modularen Berechnung zurück.
+    Die Primzahlen sind absteigend die größten Primzahlen unter 2^62, sodass die Summe zweier Reste noch in 64 Bit passt. Sie werden bei Bedarf mit Miller-Rabin bestimmt und behalten.
+    @param i: Index der Primzahl
+    @returns Die Primzahl
+ */
+std::uint64_t getModularPrimzahl( std::size_t i );
+
+/**
+    @brief Bestimmt den Bruch zum Rest x modulo modul (rationale Rekonstruktion).
+    Der erweiterte Euklidische Algorithmus wird abgebrochen, sobald der Rest kleiner als die Wurzel aus modul / 2 ist. Zähler z und Nenner n mit |z|, n < Wurzel( modul / 2 ) sind damit eindeutig bestimmt (Wang).
+    @param x: Der Rest, 0 <= x < modul
+    @param modul: Das Produkt der Primzahlen
+    @param ergebnis: Der gekürzte Bruch z/n mit z ≡ x * n
+    @returns False, wenn es keinen solchen Bruch gibt
+ */
+bool rekonstruiereBruch( const Langzahl& x, const Langzahl& modul, Bruch<Langzahl>& ergebnis );
+
+/**
+    @brief Berechnet einen Term mit Restklassen nach mehreren Primzahlen und setzt das exakte Ergebnis daraus zusammen.
+    Der Term wird einmal als Termprogramm übersetzt und dann für jede Primzahl p mit Zähler und Nenner modulo p berechnet, ohne zu dividieren. Die Reste werden
+    mit dem Chinesischen Restsatz (Garner) zu einem Rest modulo des Produkts der Primzahlen zusammengesetzt, aus dem rekonstruiereBruch den Bruch bestimmt.
+    Jede Primzahl wird unabhängig gerechnet, die Primzahlen eines Durchgangs werden auf die Threads von pool verteilt.
+    Aus der Bitbreite der Zahlen und den Rechenzeichen folgt eine Schranke für das Ergebnis. Ist das Produkt der Primzahlen größer, ist das Ergebnis bewiesen.
+    Meist ist das gekürzte Ergebnis viel kleiner: Dann wird schon vorher rekonstruiert und das Ergebnis mit den Resten des nächsten Durchgangs geprüft.
+    Ist die Rekonstruktion bis zur Schranke nicht möglich oder teilt jede Primzahl eines Durchgangs den Nenner (z.B. bei einer Division durch 0), wird mit berechneNaechstenTerm<Langzahl> exakt gerechnet.
+    Grammatik und Fehlermeldungen entsprechen berechneNaechstenTerm, "k" hat keine Wirkung, da das Ergebnis immer gekürzt ist.
+    @param term: der zu berechnende Term in Postfixnotation
+    @param pool: Der Arbeitspool für die Primzahlen
+    @param bericht: Wenn nicht nullptr, werden hier Angaben zum Verlauf abgelegt
+    @returns Das vollständig gekürzte Endergebnis
+ */
+Bruch<Langzahl> berechneTermModular( std::string_view term, Arbeitspool& pool, Modularbericht* bericht = nullptr );
+
+/**
+    @brief Berechnet einen Term mit Restklassen auf einem eigenen Arbeitspool.
+    @param threads: Anzahl der Arbeitsthreads, 0 = Anzahl der Prozessorkerne, 1 = ohne Threads
+ */
+Bruch<Langzahl> berechneTermModular( std::string_view term, unsigned threads = 0, Modularbericht* bericht = nullptr );
+
+#endif // MODULARRECHNER_H
@@ -0,0 +1,224 @@
+#include "Stapelverarbeitung.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Bruchberechner.h"
+#include "Ausgabe.h"
+#include "Termstrom.h"
+#include "Ergebniscache.h"
+
+/**
+    @brief Bildet eine Datei nur lesend in den Speicher ab.
+    Der Destruktor gibt die Abbildung wieder frei. Leere Dateien werden nicht abgebildet, ihr Inhalt ist leer.
+ */
+class Dateiabbild {
+    public:
+        explicit Dateiabbild( const std::string& pfad )
+            : daten( nullptr ), groesse( 0 ) {
+            const int datei = open( pfad.c_str(), O_RDONLY );
+            if( datei < 0 )
+                throw std::runtime_error( "Die Datei " + pfad + " konnte nicht geöffnet werden." );
+            struct stat info;
+            if( fstat( datei, &info ) == 0 && info.st_size > 0 ) {
+                groesse = info.st_size;
+                void* abbild = mmap( nullptr, groesse, PROT_READ, MAP_PRIVATE, datei, 0 );
+                if( abbild == MAP_FAILED ) {
+                    close( datei );
+                    throw std::runtime_error( "Die Datei " + pfad + " konnte nicht in den Speicher abgebildet werden." );
+                }
+                daten = static_cast<const char*>( abbild );
+                madvise( abbild, groesse, MADV_SEQUENTIAL );
+            }
+            close( datei );
+        }
+        ~Dateiabbild() {
+            if( daten )
+                munmap( const_cast<char*>( daten ), groesse );
+        }
+        Dateiabbild( const Dateiabbild& ) = delete;
+        Dateiabbild& operator = ( const Dateiabbild& ) = delete;
+
+        std::string_view inhalt() const {
+            return std::string_view( daten, groesse );
+        }
+
+    private:
+        const char* daten;
+        std::size_t groesse;
+};
+
+void berechneZeile( std::string_view zeile, std::string& ausgabe, bool geprueft, bool infix, Ergebniscache* cache ) {
+    ///Mit Cache wird zuerst unter dem normalisierten Term nachgesehen. Bei einem Treffer entfallen Zerlegen und Berechnen.
+    thread_local std::string schluessel;
+    if( cache ) {
+        Ergebniscache::normalisiere( zeile, schluessel );
+        Ergebniscache::Eintrag eintrag;
+        if( cache->suche( schluessel, eintrag ) ) {
+            if( eintrag.fehler == Fehlercode::KeinFehler ) {
+                haengeBruchAn( ausgabe, eintrag.wert );
+                ausgabe += "\n\n";
+                return;
+            }
+            ausgabe += "Bei der Berechnung ist ein Fehler aufgetreten:\n\"";
+            haengeFehlermeldungAn( ausgabe, eintrag.fehler, std::string_view( &eintrag.fehlerzeichen, 1 ), 0, eintrag.stellen );
+            ausgabe += "\"\n\n";
+            return;
+        }
+    }
+    ///Fehler im Term kommen als Fehlercode zurück, die Meldung wird direkt an die Ausgabe angehängt.
+    auto haengeErgebnisAn = [&]( const auto & ergebnis ) {
+        if( cache ) {
+            Ergebniscache::Eintrag eintrag;
+            eintrag.fehler = ergebnis.fehler;
+            eintrag.stellen = ergebnis.stellen;
+            if( ergebnis )
+                eintrag.wert = ergebnis.wert;
+            else if( ergebnis.position < zeile.size() )
+                eintrag.fehlerzeichen = zeile[ergebnis.position];
+            cache->speichere( schluessel, eintrag );
+        }
+        if( ergebnis ) {
+            haengeBruchAn( ausgabe, ergebnis.wert );
+            ausgabe += "\n\n";
+            return;
+        }
+        ausgabe += "Bei der Berechnung ist ein Fehler aufgetreten:\n\"";
+        haengeFehlermeldungAn( ausgabe, ergebnis.fehler, zeile, ergebnis.position, ergebnis.stellen );
+        ausgabe += "\"\n\n";
+    };
+    try {
+        if( geprueft )
+            haengeErgebnisAn( berechneTermMitUeberlaufschutzOhneAusnahme( zeile, infix ) );
+        else if( infix )
+            haengeErgebnisAn( berechneInfixTermOhneAusnahme<long int>( zeile ) );
+        else
+            haengeErgebnisAn( berechneNaechstenTermOhneAusnahme<long int>( zeile ) );
+    } catch( const std::runtime_error& e ) {
+        ausgabe += "Bei der Berechnung ist ein Fehler aufgetreten:\n\"";
+        ausgabe += e.what();
+        ausgabe += "\"\n\n";
+    } catch( const std::exception& e ) {
+        ausgabe += "Bei der Berechnung ist ein unerwarteter Fehler aufgetreten:\n\"";
+        ausgabe += e.what();
+        ausgabe += "\"\n\n";
+    }
+}
+
+/**
+    @brief Zerlegt text an Zeilengrenzen in Abschnitte von etwa zielgroesse Zeichen.
+    @returns Die Abschnitte, jeder endet mit einem Zeilenumbruch oder am Ende von text
+ */
+static std::vector<std::string_view> zerlegeInAbschnitte( std::string_view text, std::size_t zielgroesse ) {
+    std::vector<std::string_view> abschnitte;
+    while( !text.empty() ) {
+        std::size_t ende = std::min( zielgroesse, text.size() );
+        const std::size_t umbruch = text.find( '\n', ende - 1 );
+        ende = umbruch == std::string_view::npos ? text.size() : umbruch + 1;
+        abschnitte.push_back( text.substr( 0, ende ) );
+        text.remove_prefix( ende );
+    }
+    return abschnitte;
+}
+
+void berechneDatei( const std::string& pfad, Ausgabepuffer& ausgabe, unsigned threads, bool geprueft, bool infix, Ergebniscache* cache ) {
+    const Dateiabbild datei( pfad );
+    if( threads == 0 )
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+    ///Mehrere Abschnitte pro Thread gleichen unterschiedlich teure Zeilen aus, ohne dass die Verwaltung ins Gewicht fällt.
+    const std::size_t zielgroesse = std::max<std::size_t>( 1 << 16, datei.inhalt().size() / ( 16 * threads ) );
+    const auto abschnitte = zerlegeInAbschnitte( datei.inhalt(), zielgroesse );
+    std::vector<std::string> ergebnisse( abschnitte.size() );
+    std::vector<bool> fertig( abschnitte.size(), false );
+    std::mutex sperre;
+    std::condition_variable abschnittFertig;
+    std::atomic<std::size_t> naechsterAbschnitt( 0 );
+
+    auto arbeiter = [&]() {
+        for( std::size_t i = naechsterAbschnitt++; i < abschnitte.size(); i = naechsterAbschnitt++ ) {
+            std::string ergebnis;
+            std::string_view rest = abschnitte[i];
+            while( !rest.empty() ) {
+                const std::size_t umbruch = std::min( rest.find( '\n' ), rest.size() );
+                berechneZeile( rest.substr( 0, umbruch ), ergebnis, geprueft, infix, cache );
+                rest.remove_prefix( std::min( umbruch + 1, rest.size() ) );
+            }
+            {
+                std::lock_guard<std::mutex> wache( sperre );
+                ergebnisse[i] = std::move( ergebnis );
+                fertig[i] = true;
+            }
+            abschnittFertig.notify_one();
+        }
+    };
+    std::vector<std::thread> arbeiterThreads;
+    for( unsigned t = 0; t < threads; t++ )
+        arbeiterThreads.emplace_back( arbeiter );
+    ///Der aufrufende Thread gibt die Abschnitte in Eingabereihenfolge aus, sobald sie fertig sind.
+    for( std::size_t i = 0; i < abschnitte.size(); i++ ) {
+        std::string ergebnis;
+        {
+            std::unique_lock<std::mutex> wache( sperre );
+            abschnittFertig.wait( wache, [&]() {
+                return fertig[i];
+            } );
+            ergebnis = std::move( ergebnisse[i] );
+        }
+        ausgabe.schreibe( ergebnis );
+    }
+    for( auto& t : arbeiterThreads )
+        t.join();
+    ausgabe.leere();
+}
+
+/**
+    @brief Liest die Eingabe blockweise in strom und schreibt jedes Ergebnis wie berechneZeile nach ausgabe.
+ */
+template <typename T> static void berechneStrom( int dateideskriptor, Ausgabepuffer& ausgabe, std::size_t blockgroesse ) {
+    Termstrom<T> strom;
+    std::string text;
+    auto schreibeErgebnis = [&]( const Termergebnis<Bruch<T>>& ergebnis ) {
+        text.clear();
+        if( ergebnis ) {
+            haengeBruchAn( text, ergebnis.wert );
+            text += "\n\n";
+        } else {
+            text += "Bei der Berechnung ist ein Fehler aufgetreten:\n\"";
+            strom.haengeFehlermeldungAn( text, ergebnis.fehler );
+            text += "\"\n\n";
+        }
+        ausgabe.schreibe( text );
+        ausgabe.zeileFertig();
+    };
+    std::vector<char> block( blockgroesse );
+    for( ;; ) {
+        const ssize_t gelesen = read( dateideskriptor, block.data(), block.size() );
+        if( gelesen < 0 && errno == EINTR )
+            continue;
+        if( gelesen < 0 )
+            throw std::runtime_error( "Die Eingabe konnte nicht gelesen werden." );
+        if( gelesen == 0 )
+            break;
+        strom.lies( std::string_view( block.data(), gelesen ), schreibeErgebnis );
+    }
+    strom.beende( schreibeErgebnis );
+    ausgabe.leere();
+}
+
+void berechneStrom( int dateideskriptor, Ausgabepuffer& ausgabe, bool geprueft, std::size_t blockgroesse ) {
+    if( geprueft )
+        berechneStrom<Langzahl>( dateideskriptor, ausgabe, blockgroesse );
+    else
+        berechneStrom<long int>( dateideskriptor, ausgabe, blockgroesse );
+}
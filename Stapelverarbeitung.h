@@ -0,0 +1,47 @@
+#ifndef STAPELVERARBEITUNG_H
+#define STAPELVERARBEITUNG_H
+
+#include <string>
+#include <string_view>
+
+class Ausgabepuffer;
+class Ergebniscache;
+
+/**
+    @brief Berechnet eine Zeile und hängt das Ergebnis an ausgabe an.
+    Das Ergebnis wird wie im Hauptprogramm als "[Ergebnis]\n\n" angehängt und dabei mit to_chars ohne Umweg über einen Stream formatiert. Im Fall einer Exception wird stattdessen die Fehlermeldung angehängt.
+    @param zeile: Der Term in Postfixnotation
+    @param ausgabe: Die Zeichenkette, an die das Ergebnis angehängt wird
+    @param geprueft: True, wenn mit Überlaufschutz gerechnet werden soll (siehe berechneTermMitUeberlaufschutz)
+    @param infix: True, wenn der Term in Infixnotation steht (siehe berechneInfixTerm)
+    @param cache: Wenn nicht nullptr, wird das Ergebnis hier nachgeschlagen bzw. gespeichert. Der Cache darf nur für eine Kombination von geprueft und infix genutzt werden.
+ */
+void berechneZeile( std::string_view zeile, std::string& ausgabe, bool geprueft, bool infix = false, Ergebniscache* cache = nullptr );
+
+/**
+    @brief Berechnet alle Terme einer Datei auf mehreren Threads.
+    Die Datei wird in den Speicher abgebildet (mmap) und an Zeilengrenzen in Abschnitte zerlegt. Die Abschnitte werden von threads Arbeitsthreads berechnet.
+    Jede Zeile ist ein Term. Ergebnisse und Fehlermeldungen werden in der Reihenfolge der Eingabe nach ausgabe geschrieben, sobald alle vorherigen Abschnitte fertig sind.
+    @param pfad: Pfad der Eingabedatei
+    @param ausgabe: Der Ausgabepuffer für die Ergebnisse, er wird am Ende geleert
+    @param threads: Anzahl der Arbeitsthreads, 0 = Anzahl der Prozessorkerne
+    @param geprueft: True, wenn mit Überlaufschutz gerechnet werden soll
+    @param infix: True, wenn die Terme in Infixnotation stehen
+    @param cache: Wenn nicht nullptr, teilen sich alle Arbeitsthreads diesen Ergebniscache
+    @throws std::runtime_error, falls die Datei nicht gelesen werden kann
+ */
+void berechneDatei( const std::string& pfad, Ausgabepuffer& ausgabe, unsigned threads, bool geprueft, bool infix = false, Ergebniscache* cache = nullptr );
+
+/**
+    @brief Berechnet alle Terme, die über einen Dateideskriptor ankommen, ohne eine Zeile vollständig zu lesen.
+    Die Eingabe wird in Blöcken gelesen und an einen Termstrom übergeben. So können auch Terme berechnet werden, die größer als der Arbeitsspeicher sind.
+    Die Ausgabe entspricht berechneZeile für jede Zeile. Mit Überlaufschutz wird direkt mit Langzahl gerechnet, da ein Term für einen zweiten Versuch nicht mehr vorliegt.
+    @param dateideskriptor: Die Eingabe, z.B. STDIN_FILENO
+    @param ausgabe: Der Ausgabepuffer für die Ergebnisse, er wird am Ende geleert
+    @param geprueft: True, wenn mit Überlaufschutz gerechnet werden soll
+    @param blockgroesse: Größe der gelesenen Blöcke, default = 64 KiB
+    @throws std::runtime_error, falls die Eingabe nicht gelesen werden kann
+ */
+void berechneStrom( int dateideskriptor, Ausgabepuffer& ausgabe, bool geprueft, std::size_t blockgroesse = 1 << 16 );
+
+#endif // STAPELVERARBEITUNG_H
@@ -0,0 +1,54 @@
+#include "Termergebnis.h"
+
+#include <stdexcept>
+
+#include "Geprueft.h"
+
+const char* getFehlermeldung( Fehlercode fehler ) {
+    static const char* const meldungen[] = {
+        "Es ist kein Fehler aufgetreten.",
+        "Es wurde ein unbekanntes Zeichen eingegeben.",
+        "Es sind nicht genug Zahlen für diese Berechnung.",
+        "Es sind nicht genug Operatoren für diese Berechnung.",
+        "Der Ausdruck besitzt direkt nach einem Bruchstrich keine Zahl, obwohl ein Nenner erwartet wird.",
+        "Eine Division durch Null (bzw. eine Null im Nenner) ist nicht möglich.",
+        "Das Ergebnis ist für den Datentyp zu groß.",
+        "Vor einem n-stelligen Rechenzeichen (Σ, Π) muss die Anzahl als nicht negative ganze Zahl stehen.",
+        "Zu einer Klammer fehlt die öffnende bzw. schließende Klammer."
+    };
+    return meldungen[static_cast<std::size_t>( fehler )];
+}
+
+void haengeFehlermeldungAn( std::string& text, Fehlercode fehler, std::string_view term, std::size_t position, std::size_t stellen ) {
+    ///Zwei Meldungen enthalten wie bisher Angaben zum Term, die übrigen kommen unverändert aus der Tabelle.
+    switch( fehler ) {
+        case Fehlercode::UnbekanntesZeichen:
+            if( position >= term.size() ) {
+                text += getFehlermeldung( fehler );
+                break;
+            }
+            text += "Es wurde ein unbekanntes Zeichen eingegeben: ";
+            text += term[position];
+            break;
+        case Fehlercode::ZuWenigZahlen:
+            ///Die n-stelligen Rechenzeichen haben keine feste Stellenzahl.
+            if( stellen == 0 ) {
+                text += getFehlermeldung( fehler );
+                break;
+            }
+            text += "Es sind nicht genug Zahlen für diese Berechnung mit ";
+            text += std::to_string( stellen );
+            text += " Stellen.";
+            break;
+        default:
+            text += getFehlermeldung( fehler );
+    }
+}
+
+void wirfFehler( Fehlercode fehler, std::string_view term, std::size_t position, std::size_t stellen ) {
+    if( fehler == Fehlercode::Ueberlauf )
+        throw Ueberlauf();
+    std::string meldung;
+    haengeFehlermeldungAn( meldung, fehler, term, position, stellen );
+    throw std::runtime_error( meldung );
+}
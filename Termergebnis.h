@@ -0,0 +1,71 @@
+#ifndef TERMERGEBNIS_H
+#define TERMERGEBNIS_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/**
+    @brief Fehler, die bei der Berechnung eines Terms auftreten können.
+ */
+enum class Fehlercode : std::uint8_t {
+    KeinFehler,
+    UnbekanntesZeichen,         ///Ein Zeichen ist weder Zahl noch Rechenzeichen
+    ZuWenigZahlen,              ///Ein Rechenzeichen findet nicht genug Zahlen auf dem Stapel
+    ZuWenigOperatoren,          ///Am Ende liegt mehr als eine Zahl auf dem Stapel
+    NennerFehlt,                ///Auf einen Bruchstrich folgt keine Zahl
+    DivisionDurchNull,          ///Ein Nenner ist 0 oder es wird durch 0 geteilt
+    Ueberlauf,                  ///Eine Zahl oder ein Ergebnis passt nicht in den Datentyp
+    UngueltigeAnzahl,           ///Die Anzahl vor einem n-stelligen Rechenzeichen (Σ, Π) ist keine nicht negative ganze Zahl
+    Klammerfehler               ///Zu einer Klammer im Infixterm fehlt das Gegenstück
+};
+
+/**
+    @brief Ergebnis einer Berechnung ohne Exceptions.
+    Enthält entweder den Wert oder einen Fehlercode mit der Position des Zeichens im Term, an dem der Fehler festgestellt wurde.
+    @arg B: Typ des Werts
+ */
+template <typename B> struct Termergebnis {
+    B wert;
+    Fehlercode fehler;
+    ///Index des Zeichens im Term, bei ZuWenigOperatoren die Länge des Terms
+    std::size_t position;
+    ///Bei ZuWenigZahlen die Stellenzahl des Rechenzeichens, 0 wenn sie nicht feststeht (z.B. bei Σ)
+    std::size_t stellen = 0;
+
+    explicit operator bool() const {
+        return fehler == Fehlercode::KeinFehler;
+    }
+};
+
+/**
+    @brief Gibt die feste Fehlermeldung zu einem Fehlercode zurück.
+    Die Meldungen liegen in einer statischen Tabelle, es wird kein Speicher angefordert. Sie enthalten keine Angaben zum Term (z.B. das unbekannte Zeichen).
+    @param fehler: Der Fehlercode
+    @returns Die Fehlermeldung
+ */
+const char* getFehlermeldung( Fehlercode fehler );
+
+/**
+    @brief Hängt die vollständige Fehlermeldung an text an.
+    Die Meldung ist dieselbe, die berechneNaechstenTerm als Exception wirft, z.B. mit dem unbekannten Zeichen oder der Anzahl der Stellen des Rechenzeichens.
+    @param text: Die Zeichenkette, an die angehängt wird
+    @param fehler: Der Fehlercode
+    @param term: Der berechnete Term
+    @param position: Die Fehlerposition aus dem Termergebnis
+    @param stellen: Die Stellenzahl aus dem Termergebnis, default = 0 (nicht bekannt)
+ */
+void haengeFehlermeldungAn( std::string& text, Fehlercode fehler, std::string_view term, std::size_t position, std::size_t stellen = 0 );
+
+/**
+    @brief Wirft die Exception, die berechneNaechstenTerm für den Fehler geworfen hätte.
+    Ueberlauf wird als Ueberlauf geworfen, alle anderen Fehler als std::runtime_error mit der vollständigen Fehlermeldung.
+    @param fehler: Der Fehlercode
+    @param term: Der berechnete Term
+    @param position: Die Fehlerposition aus dem Termergebnis
+    @param stellen: Die Stellenzahl aus dem Termergebnis, default = 0 (nicht bekannt)
+    @pre fehler != Fehlercode::KeinFehler
+ */
+[[noreturn]] void wirfFehler( Fehlercode fehler, std::string_view term, std::size_t position, std::size_t stellen = 0 );
+
+#endif // TERMERGEBNIS_H
@@ -0,0 +1,350 @@
+#ifndef TERMGRAPH_H
+#define TERMGRAPH_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "Bruch.h"
+#include "Instrumentierung.h"
+#include "Berechner.h"
+#include "Termprogramm.h"
+
+/**
+    @brief Ein Termprogramm, in dem jeder verschiedene Teilterm nur einmal berechnet wird.
+    Die Anweisungen des Programms werden in einen gerichteten azyklischen Graphen übersetzt. Jeder Teilterm wird über sein Rechenzeichen und seine schon übersetzten Operanden nachgeschlagen,
+    ein wiederholter Teilterm (z.B. "x 1/3 +" an mehreren Stellen) wird so zu einem Verweis auf den vorhandenen Knoten. Bei "+" und "*" spielt die Reihenfolge der Operanden keine Rolle.
+    Teilterme ohne Variablen werden schon beim Übersetzen berechnet, gleiche Konstanten werden zusammengefasst. Ein Fehler dabei (z.B. eine Division durch 0) wird nicht gemeldet,
+    der Teilterm bleibt dann erhalten und der Fehler tritt wie beim Termprogramm erst beim Berechnen auf.
+    Das Ergebnis ist dasselbe wie beim Termprogramm, getGespart() gibt an, wie viele Operationen pro Berechnung wegfallen.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg K: Kürzungsstrategie für die Zwischenergebnisse
+ */
+template <typename T, typename K = KuerzeNie> class Termgraph {
+    public:
+        using BruchTyp = Bruch<T, K>;
+
+        /**
+            @brief Ein Rechenknoten des Graphen.
+            Die Operanden stehen ab erster in getOperanden(). Ein Operand ist eine Konstante, wenn das Bit konstante gesetzt ist, sonst der Index in die Werte aus Variablen und Knoten.
+         */
+        struct Knoten {
+            Befehl befehl;
+            std::uint32_t erster;
+            std::uint32_t anzahl;
+        };
+
+        ///Kennzeichnet einen Operanden als Index in die Konstanten.
+        static constexpr std::uint32_t konstante = std::uint32_t( 1 ) << 31;
+
+        /**
+            @brief Konstruktor: Übersetzt das Termprogramm in einen Graphen.
+            @param programm: Das Termprogramm
+         */
+        explicit Termgraph( const Termprogramm<T, K>& programm )
+            : anzahlVariablen( programm.getAnzahlVariablen() ), gefaltet( 0 ), wiederverwendet( 0 ), anweisungenImProgramm( 0 ) {
+            Stoppuhr uhr( Phase::Zerlegen );
+            std::vector<std::uint32_t> stapel;
+            std::vector<std::uint32_t> ops;
+            for( const auto& a : programm.getAnweisungen() ) {
+                switch( a.befehl ) {
+                    case Befehl::Konstante:
+                        stapel.push_back( getKonstante( programm.getKonstanten()[a.index] ) );
+                        continue;
+                    case Befehl::Variable:
+                        stapel.push_back( a.index );
+                        continue;
+                    default:
+                        break;
+                }
+                const std::size_t anzahl = a.befehl == Befehl::Kuerzen ? 1 : ( a.befehl == Befehl::Summe || a.befehl == Befehl::Produkt ) ? a.index : 2;
+                ops.assign( stapel.end() - anzahl, stapel.end() );
+                stapel.resize( stapel.size() - anzahl );
+                anweisungenImProgramm++;
+                stapel.push_back( uebersetze( a.befehl, ops ) );
+            }
+            ergebnis = stapel.back();
+            konstantenIndex.clear();
+            teilterme.clear();
+        }
+
+        /**
+            @brief Konstruktor: Übersetzt den Term über ein Termprogramm.
+            @throws std::runtime_error bzw. std::logic_error wie das Termprogramm, wenn der Term ungültig ist
+         */
+        explicit Termgraph( std::string_view term, std::vector<std::string> variablen = {} )
+            : Termgraph( Termprogramm<T, K>( term, std::move( variablen ) ) ) {
+        }
+
+        /**
+            @brief Berechnet den Graphen für eine Belegung der Variablen.
+            Wie beim Termprogramm fordert die Berechnung keinen Speicher an, wenn arbeitsbereich wiederverwendet wird.
+            @param belegung: Die Werte der Variablen, in der Reihenfolge der Namen beim Übersetzen
+            @param arbeitsbereich: Speicher für die Werte der Variablen und Knoten
+            @returns Das vollständig gekürzte Ergebnis
+            @pre belegung zeigt auf mindestens getAnzahlVariablen() Brüche
+         */
+        BruchTyp berechne( const BruchTyp* belegung, std::vector<BruchTyp>& arbeitsbereich ) const {
+            ///Hinter den Werten liegt Platz, um die Operanden von Summe und Produkt hintereinander zu sammeln.
+            if( arbeitsbereich.size() < anzahlVariablen + knoten.size() + breitesteReduktion )
+                arbeitsbereich.resize( anzahlVariablen + knoten.size() + breitesteReduktion );
+            Stoppuhr uhr( Phase::Rechnen );
+            BruchTyp* werte = arbeitsbereich.data();
+            std::copy( belegung, belegung + anzahlVariablen, werte );
+            auto wert = [&]( std::uint32_t operand ) -> const BruchTyp & {
+                return operand & konstante ? konstanten[operand & ~konstante] : werte[operand];
+            };
+            BruchTyp* ziel = werte + anzahlVariablen;
+            BruchTyp* sammlung = ziel + knoten.size();
+            for( const Knoten& k : knoten ) {
+                const std::uint32_t* o = operanden.data() + k.erster;
+                if constexpr( instrumentiert )
+                    erfasseKnoten( k, o, wert );
+                switch( k.befehl ) {
+                    case Befehl::Addition:
+                        *ziel = add( wert( o[0] ), wert( o[1] ) );
+                        break;
+                    case Befehl::Subtraktion:
+                        *ziel = sub( wert( o[0] ), wert( o[1] ) );
+                        break;
+                    case Befehl::Multiplikation:
+                        *ziel = mul( wert( o[0] ), wert( o[1] ) );
+                        break;
+                    case Befehl::Division:
+                        *ziel = div( wert( o[0] ), wert( o[1] ) );
+                        break;
+                    case Befehl::Kuerzen:
+                        *ziel = wert( o[0] );
+                        ziel->kuerzeBruch();
+                        break;
+                    case Befehl::Summe:
+                    case Befehl::Produkt:
+                        for( std::uint32_t i = 0; i < k.anzahl; i++ )
+                            sammlung[i] = wert( o[i] );
+                        *ziel = k.befehl == Befehl::Summe ? summiere( sammlung, k.anzahl ) : multipliziere( sammlung, k.anzahl );
+                        break;
+                    default:
+                        break;
+                }
+                ziel++;
+            }
+            ///Statt der Stapeltiefe wird die Anzahl der Knoten erfasst.
+            if constexpr( instrumentiert )
+                erfasseTerm( knoten.size() );
+            BruchTyp e = wert( ergebnis );
+            e.kuerzeBruch();
+            return e;
+        }
+
+        /**
+            @brief Berechnet den Graphen für eine Belegung der Variablen.
+            Der Arbeitsbereich wird für diesen Aufruf angelegt.
+         */
+        BruchTyp berechne( const std::vector<BruchTyp>& belegung ) const {
+            if( belegung.size() < anzahlVariablen )
+                throw std::logic_error( "Die Belegung enthält nicht für jede Variable einen Wert." );
+            std::vector<BruchTyp> arbeitsbereich;
+            return berechne( belegung.data(), arbeitsbereich );
+        }
+
+        /**
+            @brief Berechnet den Graphen für viele Belegungen, wie Termprogramm::berechneAlle.
+         */
+        void berechneAlle( const BruchTyp* belegungen, std::size_t anzahl, std::vector<BruchTyp>& ergebnisse ) const {
+            std::vector<BruchTyp> arbeitsbereich;
+            ergebnisse.reserve( ergebnisse.size() + anzahl );
+            for( std::size_t i = 0; i < anzahl; i++ )
+                ergebnisse.push_back( berechne( belegungen + i * anzahlVariablen, arbeitsbereich ) );
+        }
+
+        std::size_t getAnzahlVariablen() const {
+            return anzahlVariablen;
+        }
+
+        const std::vector<Knoten>& getKnoten() const {
+            return knoten;
+        }
+
+        const std::vector<std::uint32_t>& getOperanden() const {
+            return operanden;
+        }
+
+        const std::vector<BruchTyp>& getKonstanten() const {
+            return konstanten;
+        }
+
+        /**
+            @brief Gibt die Anzahl der Rechenanweisungen im Termprogramm zurück.
+            Das sind alle Anweisungen außer Konstanten und Variablen, also die Operationen, die das Termprogramm bei jeder Berechnung ausführt.
+         */
+        std::size_t getAnweisungenImProgramm() const {
+            return anweisungenImProgramm;
+        }
+
+        /**
+            @brief Gibt die Anzahl der Rechenanweisungen zurück, die beim Übersetzen zu Konstanten berechnet wurden.
+         */
+        std::size_t getGefaltet() const {
+            return gefaltet;
+        }
+
+        /**
+            @brief Gibt die Anzahl der Rechenanweisungen zurück, die einen schon vorhandenen Teilterm wiederholen.
+         */
+        std::size_t getWiederverwendet() const {
+            return wiederverwendet;
+        }
+
+        /**
+            @brief Gibt die Anzahl der Operationen zurück, die bei jeder Berechnung gegenüber dem Termprogramm gespart werden.
+            Das Termprogramm führt getAnweisungenImProgramm() Operationen aus, der Graph nur getKnoten().size() = getAnweisungenImProgramm() - getGespart().
+         */
+        std::size_t getGespart() const {
+            return gefaltet + wiederverwendet;
+        }
+
+    private:
+        /**
+            @brief Schlüssel eines Teilterms: Rechenzeichen und Operanden.
+         */
+        struct Schluessel {
+            Befehl befehl;
+            std::vector<std::uint32_t> operanden;
+
+            bool operator == ( const Schluessel& s ) const {
+                return befehl == s.befehl && operanden == s.operanden;
+            }
+        };
+
+        struct SchluesselHash {
+            std::size_t operator()( const Schluessel& s ) const {
+                std::size_t h = static_cast<std::size_t>( s.befehl );
+                for( const std::uint32_t o : s.operanden )
+                    h = ( h ^ o ) * 0x100000001b3ull;
+                return h;
+            }
+        };
+
+        /**
+            @brief Gibt den Operanden für die Konstante b zurück und legt sie an, falls es sie noch nicht gibt.
+            Gleich sind nur Konstanten mit gleichem Zähler und Nenner. 1/2 und 2/4 bleiben verschieden, da ungekürzte Zwischenergebnisse sonst anders ausfallen könnten.
+         */
+        std::uint32_t getKonstante( const BruchTyp& b ) {
+            const auto gefunden = konstantenIndex.emplace( std::make_pair( b.getZaehler(), b.getNenner() ), static_cast<std::uint32_t>( konstanten.size() ) );
+            if( gefunden.second )
+                konstanten.push_back( b );
+            return gefunden.first->second | konstante;
+        }
+
+        /**
+            @brief Übersetzt eine Rechenanweisung mit den Operanden ops.
+            @returns Den Operanden für das Ergebnis: einen vorhandenen Knoten, eine Konstante oder einen neuen Knoten
+         */
+        std::uint32_t uebersetze( Befehl befehl, std::vector<std::uint32_t>& ops ) {
+            ///Addition und Multiplikation sind kommutativ, die Operanden werden sortiert, damit "a b +" und "b a +" denselben Schlüssel haben.
+            if( ( befehl == Befehl::Addition || befehl == Befehl::Multiplikation ) && ops[1] < ops[0] )
+                std::swap( ops[0], ops[1] );
+            Schluessel schluessel{ befehl, ops };
+            const auto vorhanden = teilterme.find( schluessel );
+            if( vorhanden != teilterme.end() ) {
+                wiederverwendet++;
+                return vorhanden->second;
+            }
+            std::uint32_t operand = 0;
+            if( !falte( befehl, ops, operand ) ) {
+                operand = static_cast<std::uint32_t>( anzahlVariablen + knoten.size() );
+                knoten.push_back( { befehl, static_cast<std::uint32_t>( operanden.size() ), static_cast<std::uint32_t>( ops.size() ) } );
+                operanden.insert( operanden.end(), ops.begin(), ops.end() );
+                if( befehl == Befehl::Summe || befehl == Befehl::Produkt )
+                    breitesteReduktion = std::max<std::size_t>( breitesteReduktion, ops.size() );
+            }
+            teilterme.emplace( std::move( schluessel ), operand );
+            return operand;
+        }
+
+        /**
+            @brief Berechnet die Rechenanweisung schon beim Übersetzen, wenn alle Operanden Konstanten sind.
+            @param operand: Der Operand der Konstanten mit dem Ergebnis
+            @returns True, wenn die Anweisung berechnet wurde
+         */
+        bool falte( Befehl befehl, const std::vector<std::uint32_t>& ops, std::uint32_t& operand ) {
+            std::vector<BruchTyp> werte;
+            for( const std::uint32_t o : ops ) {
+                if( !( o & konstante ) )
+                    return false;
+                werte.push_back( konstanten[o & ~konstante] );
+            }
+            BruchTyp wert;
+            try {
+                switch( befehl ) {
+                    case Befehl::Addition:
+                        wert = add( werte[0], werte[1] );
+                        break;
+                    case Befehl::Subtraktion:
+                        wert = sub( werte[0], werte[1] );
+                        break;
+                    case Befehl::Multiplikation:
+                        wert = mul( werte[0], werte[1] );
+                        break;
+                    case Befehl::Division:
+                        wert = div( werte[0], werte[1] );
+                        break;
+                    case Befehl::Kuerzen:
+                        wert = werte[0];
+                        wert.kuerzeBruch();
+                        break;
+                    case Befehl::Summe:
+                        wert = summiere( werte.data(), werte.size() );
+                        break;
+                    case Befehl::Produkt:
+                        wert = multipliziere( werte.data(), werte.size() );
+                        break;
+                    default:
+                        return false;
+                }
+            } catch( const std::exception& ) {
+                return false;
+            }
+            gefaltet++;
+            operand = getKonstante( wert );
+            return true;
+        }
+
+        /**
+            @brief Zählt einen Knoten und erfasst die Bitbreite seiner k.anzahl Operanden für die Instrumentierung.
+            @param o: Die Operanden des Knotens
+            @param wert: Gibt den Wert eines Operanden zurück
+         */
+        template <typename Wert> static void erfasseKnoten( const Knoten& k, const std::uint32_t* o, const Wert& wert ) {
+            static const std::string_view rechenzeichen[] = { "", "", "+", "-", "*", "/", "k", "sum", "prod" };
+            const std::string_view name = rechenzeichen[static_cast<std::size_t>( k.befehl )];
+            if( name.empty() )
+                return;
+            zaehleRechenzeichen( name );
+            for( std::uint32_t i = 0; i < k.anzahl; i++ )
+                erfasseBitbreite( wert( o[i] ) );
+        }
+
+        std::vector<Knoten> knoten;
+        std::vector<std::uint32_t> operanden;
+        std::vector<BruchTyp> konstanten;
+        std::size_t anzahlVariablen;
+        std::size_t breitesteReduktion = 0;
+        ///Operand des Ergebnisses
+        std::uint32_t ergebnis = 0;
+        std::size_t gefaltet;
+        std::size_t wiederverwendet;
+        std::size_t anweisungenImProgramm;
+        ///Nur während des Übersetzens gefüllt
+        std::map<std::pair<T, T>, std::uint32_t> konstantenIndex;
+        std::unordered_map<Schluessel, std::uint32_t, SchluesselHash> teilterme;
+};
+
+#endif // TERMGRAPH_H
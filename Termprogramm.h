@@ -0,0 +1,268 @@
+#ifndef TERMPROGRAMM_H
+#define TERMPROGRAMM_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+
+#include "Bruch.h"
+#include "Instrumentierung.h"
+#include "Berechner.h"
+#include "Termzerleger.h"
+#include "Termergebnis.h"
+
+/**
+    @brief Befehle eines Termprogramms.
+ */
+enum class Befehl : std::uint8_t {
+    Konstante,          ///Legt konstanten[index] auf den Stapel
+    Variable,           ///Legt belegung[index] auf den Stapel
+    Addition,
+    Subtraktion,
+    Multiplikation,
+    Division,
+    Kuerzen,
+    Summe,              ///Ersetzt die obersten index Zahlen durch ihre Summe
+    Produkt             ///Ersetzt die obersten index Zahlen durch ihr Produkt
+};
+
+/**
+    @brief Ein einmal übersetzter Term in Postfixnotation, der beliebig oft berechnet werden kann.
+    Der Term wird beim Anlegen zerlegt und in eine flache Folge von Befehlen übersetzt. Die Zahlen des Terms werden als Konstanten abgelegt,
+    benannte Variablen (z.B. "x" und "y") werden zu Plätzen in der Belegung, die bei jeder Berechnung übergeben wird.
+    Beim Berechnen wird nichts mehr zerlegt oder nachgeschlagen. Fehler in der Struktur des Terms (zu wenige Zahlen oder Operatoren) werden schon beim Übersetzen gemeldet.
+    Die Grammatik entspricht der von berechneNaechstenTerm. Ein Name, der keine Variable ist, wird wie bisher Zeichen für Zeichen als Rechenzeichen gelesen, "k" bleibt also das Kürzen.
+    Übersetzt werden nur die eingebauten Rechenzeichen aus bruchoperatoren, nicht die Erweiterungen einer eigenen Operatortabelle.
+    Bei den n-stelligen Rechenzeichen "N Σ" und "N Π" muss die Anzahl N als Zahl direkt davor stehen, damit die Stapeltiefe schon beim Übersetzen feststeht.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg K: Kürzungsstrategie für die Zwischenergebnisse
+ */
+template <typename T, typename K = KuerzeNie> class Termprogramm {
+    public:
+        using BruchTyp = Bruch<T, K>;
+
+        /**
+            @brief Eine Anweisung des Programms.
+            index ist bei Konstante der Index in die Konstanten, bei Variable der Platz in der Belegung, bei Summe und Produkt die Anzahl der Operanden, sonst 0.
+         */
+        struct Anweisung {
+            Befehl befehl;
+            std::uint32_t index;
+        };
+
+        /**
+            @brief Konstruktor: Übersetzt den Term.
+            @param term: Der Term in Postfixnotation
+            @param variablen: Die Namen der Variablen, ihre Reihenfolge ist die Reihenfolge in der Belegung
+            @throws std::runtime_error bzw. std::logic_error wie berechneNaechstenTerm, wenn der Term ungültig ist
+         */
+        explicit Termprogramm( std::string_view term, std::vector<std::string> variablen = {} )
+            : variablen( std::move( variablen ) ), stapeltiefe( 0 ) {
+            Stoppuhr uhr( Phase::Zerlegen );
+            Termzerleger zerleger( term );
+            std::size_t hoehe = 0;
+            ///Jeder Befehl verändert die Höhe des Stapels um einen festen Wert. So wird die maximale Tiefe schon hier bestimmt und Fehler fallen vor der ersten Berechnung auf.
+            auto operation = [&]( Befehl befehl ) {
+                if( hoehe < 2 )
+                    throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung mit 2 Stellen." );
+                hoehe--;
+                anweisungen.push_back( { befehl, 0 } );
+            };
+            while( zerleger.ueberspringeLeerzeichen() ) {
+                if( zerleger.naechsteIstZahl() ) {
+                    anweisungen.push_back( { Befehl::Konstante, static_cast<std::uint32_t>( konstanten.size() ) } );
+                    konstanten.push_back( zerleger.leseBruch<T, K>() );
+                    stapeltiefe = std::max( stapeltiefe, ++hoehe );
+                    continue;
+                }
+                const std::string_view name = zerleger.naechsterName();
+                const auto variable = std::find( this->variablen.begin(), this->variablen.end(), name );
+                if( !name.empty() && variable != this->variablen.end() ) {
+                    zerleger.ueberspringe( name.size() );
+                    anweisungen.push_back( { Befehl::Variable, static_cast<std::uint32_t>( variable - this->variablen.begin() ) } );
+                    stapeltiefe = std::max( stapeltiefe, ++hoehe );
+                    continue;
+                }
+                const char reduktion = zerleger.leseReduktion();
+                if( reduktion != 0 ) {
+                    ///Die Anzahl wird aus der vorangehenden Konstante in die Anweisung übernommen.
+                    if( anweisungen.empty() || anweisungen.back().befehl != Befehl::Konstante )
+                        throw std::runtime_error( getFehlermeldung( Fehlercode::UngueltigeAnzahl ) );
+                    std::size_t anzahl = 0;
+                    if( !leseAnzahl( konstanten.back(), hoehe - 1, anzahl ) )
+                        throw std::runtime_error( getFehlermeldung( Fehlercode::UngueltigeAnzahl ) );
+                    if( anzahl > hoehe - 1 )
+                        throw std::runtime_error( getFehlermeldung( Fehlercode::ZuWenigZahlen ) );
+                    konstanten.pop_back();
+                    anweisungen.back() = { reduktion == '+' ? Befehl::Summe : Befehl::Produkt, static_cast<std::uint32_t>( anzahl ) };
+                    ///Anzahl und Operanden werden entfernt, das Ergebnis kommt hinzu.
+                    hoehe -= anzahl;
+                    continue;
+                }
+                const char c = zerleger.leseZeichen();
+                switch( c ) {
+                    case '+':
+                        operation( Befehl::Addition );
+                        break;
+                    case '-':
+                        operation( Befehl::Subtraktion );
+                        break;
+                    case '*':
+                        operation( Befehl::Multiplikation );
+                        break;
+                    case '/':
+                        operation( Befehl::Division );
+                        break;
+                    case 'k':
+                        if( hoehe < 1 )
+                            throw std::runtime_error( "Es sind nicht genug Zahlen für diese Berechnung mit 1 Stellen." );
+                        anweisungen.push_back( { Befehl::Kuerzen, 0 } );
+                        break;
+                    default:
+                        throw std::runtime_error( "Es wurde ein unbekanntes Zeichen eingegeben: " + std::string( 1, c ) );
+                }
+            }
+            if( 1 < hoehe )
+                throw std::runtime_error( "Es sind nicht genug Operatoren für diese Berechnung." );
+            ///Ein leerer Term ergibt wie bei berechneNaechstenTerm 0.
+            if( 0 == hoehe ) {
+                anweisungen.push_back( { Befehl::Konstante, static_cast<std::uint32_t>( konstanten.size() ) } );
+                konstanten.push_back( BruchTyp( 0 ) );
+                stapeltiefe = 1;
+            }
+        }
+
+        /**
+            @brief Berechnet das Programm für eine Belegung der Variablen.
+            Die Berechnung fordert selbst keinen Speicher an, wenn arbeitsbereich bereits groß genug ist (getStapeltiefe()). Wird er wiederverwendet, geschieht das also nur beim ersten Aufruf.
+            @param belegung: Die Werte der Variablen, in der Reihenfolge der Namen beim Übersetzen
+            @param arbeitsbereich: Speicher für den Zahlenstapel
+            @returns Das vollständig gekürzte Ergebnis
+            @pre belegung zeigt auf mindestens getAnzahlVariablen() Brüche
+         */
+        BruchTyp berechne( const BruchTyp* belegung, std::vector<BruchTyp>& arbeitsbereich ) const {
+            if( arbeitsbereich.size() < stapeltiefe )
+                arbeitsbereich.resize( stapeltiefe );
+            Stoppuhr uhr( Phase::Rechnen );
+            ///spitze zeigt immer auf den ersten freien Platz des Stapels.
+            BruchTyp* spitze = arbeitsbereich.data();
+            for( const Anweisung& a : anweisungen ) {
+                if constexpr( instrumentiert )
+                    erfasseAnweisung( a, spitze );
+                switch( a.befehl ) {
+                    case Befehl::Konstante:
+                        *spitze++ = konstanten[a.index];
+                        break;
+                    case Befehl::Variable:
+                        *spitze++ = belegung[a.index];
+                        break;
+                    case Befehl::Addition:
+                        spitze--;
+                        spitze[-1] = add( spitze[-1], spitze[0] );
+                        break;
+                    case Befehl::Subtraktion:
+                        spitze--;
+                        spitze[-1] = sub( spitze[-1], spitze[0] );
+                        break;
+                    case Befehl::Multiplikation:
+                        spitze--;
+                        spitze[-1] = mul( spitze[-1], spitze[0] );
+                        break;
+                    case Befehl::Division:
+                        spitze--;
+                        spitze[-1] = div( spitze[-1], spitze[0] );
+                        break;
+                    case Befehl::Kuerzen:
+                        spitze[-1].kuerzeBruch();
+                        break;
+                    case Befehl::Summe:
+                        spitze -= a.index;
+                        *spitze = summiere( spitze, a.index );
+                        spitze++;
+                        break;
+                    case Befehl::Produkt:
+                        spitze -= a.index;
+                        *spitze = multipliziere( spitze, a.index );
+                        spitze++;
+                        break;
+                }
+            }
+            if constexpr( instrumentiert )
+                erfasseTerm( stapeltiefe );
+            BruchTyp ergebnis = arbeitsbereich.front();
+            ergebnis.kuerzeBruch();
+            return ergebnis;
+        }
+
+        /**
+            @brief Berechnet das Programm für eine Belegung der Variablen.
+            Der Arbeitsbereich wird für diesen Aufruf angelegt. Für viele Berechnungen sollte berechneAlle oder berechne mit Arbeitsbereich genutzt werden.
+         */
+        BruchTyp berechne( const std::vector<BruchTyp>& belegung ) const {
+            if( belegung.size() < variablen.size() )
+                throw std::logic_error( "Die Belegung enthält nicht für jede Variable einen Wert." );
+            std::vector<BruchTyp> arbeitsbereich;
+            return berechne( belegung.data(), arbeitsbereich );
+        }
+
+        /**
+            @brief Berechnet das Programm für viele Belegungen.
+            Die Belegungen liegen hintereinander ab belegungen, je getAnzahlVariablen() Brüche pro Belegung. Der Arbeitsbereich wird nur einmal angelegt.
+            @param belegungen: Die Belegungen
+            @param anzahl: Anzahl der Belegungen
+            @param ergebnisse: Der Vektor, an den die Ergebnisse in derselben Reihenfolge angehängt werden
+         */
+        void berechneAlle( const BruchTyp* belegungen, std::size_t anzahl, std::vector<BruchTyp>& ergebnisse ) const {
+            std::vector<BruchTyp> arbeitsbereich( stapeltiefe );
+            ergebnisse.reserve( ergebnisse.size() + anzahl );
+            for( std::size_t i = 0; i < anzahl; i++ )
+                ergebnisse.push_back( berechne( belegungen + i * variablen.size(), arbeitsbereich ) );
+        }
+
+        std::size_t getAnzahlVariablen() const {
+            return variablen.size();
+        }
+
+        /**
+            @brief Gibt die größte Anzahl an Zahlen zurück, die während der Berechnung gleichzeitig auf dem Stapel liegen.
+         */
+        std::size_t getStapeltiefe() const {
+            return stapeltiefe;
+        }
+
+        const std::vector<Anweisung>& getAnweisungen() const {
+            return anweisungen;
+        }
+
+        const std::vector<BruchTyp>& getKonstanten() const {
+            return konstanten;
+        }
+
+    private:
+        /**
+            @brief Zählt eine Rechenanweisung und erfasst die Bitbreite ihrer Operanden für die Instrumentierung.
+            @param a: Die Anweisung
+            @param spitze: Der erste freie Platz des Stapels vor der Anweisung
+         */
+        static void erfasseAnweisung( const Anweisung& a, const BruchTyp* spitze ) {
+            static const std::string_view rechenzeichen[] = { "", "", "+", "-", "*", "/", "k", "sum", "prod" };
+            const std::string_view name = rechenzeichen[static_cast<std::size_t>( a.befehl )];
+            if( name.empty() )
+                return;
+            zaehleRechenzeichen( name );
+            ///Summe und Produkt haben index Operanden.
+            const std::size_t stellen = a.befehl == Befehl::Summe || a.befehl == Befehl::Produkt ? a.index : ( a.befehl == Befehl::Kuerzen ? 1 : 2 );
+            for( std::size_t i = 1; i <= stellen; i++ )
+                erfasseBitbreite( spitze[-static_cast<std::ptrdiff_t>( i )] );
+        }
+
+        std::vector<Anweisung> anweisungen;
+        std::vector<BruchTyp> konstanten;
+        std::vector<std::string> variablen;
+        std::size_t stapeltiefe;
+};
+
+#endif // TERMPROGRAMM_H
@@ -0,0 +1,395 @@
+#ifndef TERMRECHNER_H
+#define TERMRECHNER_H
+
+#include <vector>
+#include <string_view>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Bruch.h"
+#include "Instrumentierung.h"
+#include "Termzerleger.h"
+#include "Termergebnis.h"
+#include "Berechner.h"
+#include "Bruchoperatoren.h"
+
+/**
+    @brief Berechnet Terme in Postfixnotation und behält dabei seinen Zahlenstapel.
+    Anders als berechneNaechstenTerm legt der Termrechner nicht für jeden Term einen neuen std::vector an. Der Stapel liegt zunächst in einem Puffer im Objekt,
+    der für übliche Terme reicht. Erst wenn ein Term mehr Zahlen gleichzeitig braucht, wird ein größerer Stapel auf dem Heap angelegt und für alle weiteren Terme behalten.
+    Die Rechenzeichen der Postfixnotation kommen aus der Operatortabelle von Operatoren (siehe Bruchoperatoren). Sie arbeiten direkt auf den obersten Plätzen des Stapels,
+    statt die Zahlen herauszukopieren und das Ergebnis wieder anzuhängen. Eigene Rechenzeichen werden über einen eigenen Typ Operatoren eingeführt, ohne den Termrechner zu ändern.
+    Ein Termrechner hat keinen gemeinsamen Zustand mit anderen Objekten. Jeder Thread kann also seinen eigenen Termrechner nutzen, ein Objekt darf aber nicht von mehreren Threads gleichzeitig genutzt werden.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg K: Kürzungsstrategie für die Zwischenergebnisse
+    @arg Puffergroesse: Anzahl der Zahlen, die ohne Heap auf den Stapel passen
+    @arg Operatoren: Typ mit der Operatortabelle als Konstante tabelle, default = Bruchoperatoren
+ */
+template <typename T, typename K = KuerzeNie, std::size_t Puffergroesse = 16, typename Operatoren = Bruchoperatoren<Bruch<T, K>>> class Termrechner {
+    public:
+        using BruchTyp = Bruch<T, K>;
+
+        Termrechner()
+            : stapel( puffer ), kapazitaet( Puffergroesse ), hoehe( 0 ), tiefste( 0 ), fehlerstellen( 0 ) {
+        }
+
+        ///Der Stapel kann in den eigenen Puffer zeigen, eine Kopie würde ihn teilen.
+        Termrechner( const Termrechner& ) = delete;
+        Termrechner& operator = ( const Termrechner& ) = delete;
+
+        /**
+            @brief Berechnet das Ergebnis von term.
+            Grammatik, Ergebnis und Fehlermeldungen entsprechen berechneNaechstenTerm mit derselben Operatortabelle, einschließlich der n-stelligen Rechenzeichen "N Σ" und "N Π".
+            @param term: der zu berechnende Term
+            @returns Das vollständig gekürzte Endergebnis
+         */
+        BruchTyp berechne( std::string_view term ) {
+            Termergebnis<BruchTyp> ergebnis = berechneOhneAusnahme( term );
+            if( !ergebnis )
+                wirfFehler( ergebnis.fehler, term, ergebnis.position, ergebnis.stellen );
+            return ergebnis.wert;
+        }
+
+        /**
+            @brief Berechnet das Ergebnis von term, ohne Exceptions zu werfen.
+            Fehler im Term werden als Fehlercode mit der Position des Zeichens zurückgegeben, an dem sie festgestellt wurden. Dabei wird keine Fehlermeldung erzeugt und kein Speicher angefordert.
+            Auch ein Überlauf überlaufgeprüfter Zahlen (Geprueft) und ein Nenner, der durch Überlauf eingebauter Zahlen 0 wird (NennerNull), werden als Fehlercode gemeldet.
+            Andere Exceptions eigener Rechenzeichen werden weitergegeben.
+            @param term: der zu berechnende Term
+            @returns Das vollständig gekürzte Endergebnis oder den Fehler
+         */
+        Termergebnis<BruchTyp> berechneOhneAusnahme( std::string_view term ) {
+            beginne();
+            Termzerleger zerleger( term );
+            while( zerleger.ueberspringeLeerzeichen() ) {
+                const std::size_t anfang = zerleger.getPosition();
+                const Fehlercode fehler = verarbeite( zerleger );
+                if( fehler != Fehlercode::KeinFehler )
+                    return { BruchTyp(), fehler, anfang, fehlerstellen };
+            }
+            return beende( term.size() );
+        }
+
+        /**
+            @brief Beginnt einen neuen Term, der mit verarbeite Stück für Stück berechnet wird.
+            beginne, verarbeite und beende zerlegen berechneOhneAusnahme in Schritte. So kann ein Term berechnet werden, der nie vollständig im Speicher liegt (siehe Termstrom).
+         */
+        void beginne() {
+            ///Nach einem Fehler im letzten Term können noch Zahlen auf dem Stapel liegen, sie werden einfach überschrieben.
+            hoehe = 0;
+            tiefste = 0;
+            fehlerstellen = 0;
+        }
+
+        /**
+            @brief Verarbeitet die Zahl oder das Rechenzeichen an der aktuellen Position von zerleger.
+            @param zerleger: Der Termzerleger, er wird hinter die Zahl bzw. das Rechenzeichen gerückt
+            @returns Den Fehler oder KeinFehler. Nach einem Fehler muss der Term mit beginne neu begonnen werden. Bei ZuWenigZahlen gibt getFehlerstellen die Stellenzahl zurück.
+            @pre zerleger steht auf einem Zeichen, das kein whitespace char ist
+         */
+        Fehlercode verarbeite( Termzerleger& zerleger ) {
+            try {
+                if( zerleger.naechsteIstZahl() ) {
+                    Stoppuhr uhr( Phase::Zerlegen );
+                    BruchTyp b;
+                    const Fehlercode fehler = zerleger.leseBruchOhneAusnahme( b );
+                    if( fehler != Fehlercode::KeinFehler )
+                        return fehler;
+                    lege( std::move( b ) );
+                    if constexpr( instrumentiert )
+                        tiefste = std::max( tiefste, hoehe );
+                    return Fehlercode::KeinFehler;
+                }
+                ///Wie bei berechneNaechstenTerm wird das längste passende Rechenzeichen gewählt.
+                Fehlercode fehler = Fehlercode::UnbekanntesZeichen;
+                const std::size_t laenge = Operatoren::tabelle.finde( zerleger.getRest(), [this, &fehler]( const auto& eintrag ) {
+                    fehler = wendeAn( eintrag );
+                    if( fehler == Fehlercode::ZuWenigZahlen )
+                        fehlerstellen = getStellen<BruchTyp>( eintrag );
+                } );
+                zerleger.ueberspringe( laenge );
+                return fehler;
+            } catch( const Ueberlauf& ) {
+                return Fehlercode::Ueberlauf;
+            } catch( const NennerNull& ) {
+                return Fehlercode::DivisionDurchNull;
+            }
+        }
+
+        /**
+            @brief Schließt den Term ab, nachdem alle Zahlen und Rechenzeichen verarbeitet wurden.
+            @param laenge: Länge des Terms, sie wird bei ZuWenigOperatoren als Fehlerposition zurückgegeben
+            @returns Das vollständig gekürzte Endergebnis oder den Fehler
+         */
+        Termergebnis<BruchTyp> beende( std::size_t laenge ) {
+            if( 1 < hoehe )
+                return { BruchTyp(), Fehlercode::ZuWenigOperatoren, laenge };
+            if constexpr( instrumentiert )
+                erfasseTerm( tiefste );
+            if( 0 == hoehe )
+                return { BruchTyp( 0 ), Fehlercode::KeinFehler, 0 };
+            BruchTyp b = stapel[0];
+            b.kuerzeBruch();
+            return { b, Fehlercode::KeinFehler, 0 };
+        }
+
+        /**
+            @brief Berechnet das Ergebnis von term in Infixnotation, z.B. "(1/2 + 3/4) * -5/6".
+            Der Term wird mit dem Shunting-yard-Verfahren (Dijkstra) in einem Durchgang gelesen: Zahlen kommen sofort auf den Zahlenstapel,
+            Rechenzeichen warten auf einem Operatorstapel, bis alle Rechenzeichen mit höherem Rang berechnet sind. Es entsteht kein Postfixterm als Zwischenschritt,
+            gerechnet wird mit denselben Operationen wie bei berechneOhneAusnahme.
+            "*" und "/" binden stärker als "+" und "-", alle sind linksassoziativ. Ein Minus, vor dem keine Zahl und keine schließende Klammer steht, ist ein Vorzeichen und bindet am stärksten.
+            Nur dort gilt die Regel von naechsteIstZahl, dass "-" mit direkt folgender Ziffer eine negative Zahl ist. Nach einer Zahl ist "-5" also eine Subtraktion.
+            Ein Bruch "3/4" wird als Zahl gelesen, das ergibt denselben Wert wie die Division 3 / 4.
+            @param term: der zu berechnende Term
+            @returns Das vollständig gekürzte Endergebnis oder den Fehler. Klammerfehler zeigt auf die Klammer ohne Gegenstück,
+            ZuWenigZahlen auf das Rechenzeichen ohne Operand und ZuWenigOperatoren auf eine Zahl, vor der ein Rechenzeichen fehlt.
+         */
+        Termergebnis<BruchTyp> berechneInfixOhneAusnahme( std::string_view term ) {
+            beginne();
+            ///Wie der Zahlenstapel bleibt der Operatorstapel über alle Terme erhalten.
+            operatoren.clear();
+            Termzerleger zerleger( term );
+            bool erwarteZahl = true;
+            std::size_t anfang = 0;
+            try {
+                while( zerleger.ueberspringeLeerzeichen() ) {
+                    anfang = zerleger.getPosition();
+                    if( erwarteZahl && zerleger.naechsteIstZahl() ) {
+                        Stoppuhr uhr( Phase::Zerlegen );
+                        BruchTyp b;
+                        const Fehlercode fehler = zerleger.leseBruchOhneAusnahme( b, true );
+                        if( fehler != Fehlercode::KeinFehler )
+                            return { BruchTyp(), fehler, anfang };
+                        lege( std::move( b ) );
+                        if constexpr( instrumentiert )
+                            tiefste = std::max( tiefste, hoehe );
+                        erwarteZahl = false;
+                        continue;
+                    }
+                    if( !erwarteZahl && zerleger.naechsteIstZahl() && term[anfang] != '-' )
+                        return { BruchTyp(), Fehlercode::ZuWenigOperatoren, anfang };
+                    const char c = zerleger.leseZeichen();
+                    const int rang = getInfixRang( c );
+                    if( erwarteZahl ) {
+                        ///Vor einem Operanden sind nur öffnende Klammern und Vorzeichen erlaubt.
+                        if( c == '(' || c == '-' )
+                            operatoren.push_back( { c == '-' ? 'n' : c, anfang } );
+                        else if( c != '+' )
+                            return { BruchTyp(), rang > 0 || c == ')' ? Fehlercode::ZuWenigZahlen : Fehlercode::UnbekanntesZeichen, anfang, getInfixStellen( c ) };
+                        continue;
+                    }
+                    if( c == ')' ) {
+                        for( ; !operatoren.empty() && operatoren.back().zeichen != '('; operatoren.pop_back() ) {
+                            const Fehlercode fehler = rechne( operatoren.back().zeichen );
+                            if( fehler != Fehlercode::KeinFehler )
+                                return { BruchTyp(), fehler, operatoren.back().position, getInfixStellen( operatoren.back().zeichen ) };
+                        }
+                        if( operatoren.empty() )
+                            return { BruchTyp(), Fehlercode::Klammerfehler, anfang };
+                        operatoren.pop_back();
+                        continue;
+                    }
+                    if( rang == 0 )
+                        return { BruchTyp(), c == '(' ? Fehlercode::ZuWenigOperatoren : Fehlercode::UnbekanntesZeichen, anfang };
+                    for( ; !operatoren.empty() && getInfixRang( operatoren.back().zeichen ) >= rang; operatoren.pop_back() ) {
+                        const Fehlercode fehler = rechne( operatoren.back().zeichen );
+                        if( fehler != Fehlercode::KeinFehler )
+                            return { BruchTyp(), fehler, operatoren.back().position, getInfixStellen( operatoren.back().zeichen ) };
+                    }
+                    operatoren.push_back( { c, anfang } );
+                    erwarteZahl = true;
+                }
+                if( erwarteZahl && !operatoren.empty() )
+                    return { BruchTyp(), Fehlercode::ZuWenigZahlen, operatoren.back().position, getInfixStellen( operatoren.back().zeichen ) };
+                for( ; !operatoren.empty(); operatoren.pop_back() ) {
+                    anfang = operatoren.back().position;
+                    if( operatoren.back().zeichen == '(' )
+                        return { BruchTyp(), Fehlercode::Klammerfehler, anfang };
+                    const Fehlercode fehler = rechne( operatoren.back().zeichen );
+                    if( fehler != Fehlercode::KeinFehler )
+                        return { BruchTyp(), fehler, anfang, getInfixStellen( operatoren.back().zeichen ) };
+                }
+            } catch( const Ueberlauf& ) {
+                return { BruchTyp(), Fehlercode::Ueberlauf, anfang };
+            } catch( const NennerNull& ) {
+                return { BruchTyp(), Fehlercode::DivisionDurchNull, anfang };
+            }
+            return beende( term.size() );
+        }
+
+        /**
+            @brief Berechnet das Ergebnis von term in Infixnotation.
+            @param term: der zu berechnende Term
+            @returns Das vollständig gekürzte Endergebnis
+         */
+        BruchTyp berechneInfix( std::string_view term ) {
+            Termergebnis<BruchTyp> ergebnis = berechneInfixOhneAusnahme( term );
+            if( !ergebnis )
+                wirfFehler( ergebnis.fehler, term, ergebnis.position, ergebnis.stellen );
+            return ergebnis.wert;
+        }
+
+        /**
+            @brief Gibt die Stellenzahl des Rechenzeichens zurück, für das verarbeite zuletzt ZuWenigZahlen gemeldet hat, 0 wenn sie nicht feststeht.
+         */
+        std::size_t getFehlerstellen() const {
+            return fehlerstellen;
+        }
+
+        /**
+            @brief Gibt zurück, wie viele Zahlen der Stapel derzeit ohne neue Speicheranforderung aufnehmen kann.
+         */
+        std::size_t getKapazitaet() const {
+            return kapazitaet;
+        }
+
+    private:
+        /**
+            @brief Ein Rechenzeichen auf dem Operatorstapel der Infixberechnung.
+         */
+        struct Infixoperator {
+            ///'+', '-', '*', '/', 'n' (Vorzeichen) oder '('
+            char zeichen;
+            ///Position im Term für Fehlermeldungen
+            std::size_t position;
+        };
+
+        /**
+            @brief Gibt den Rang eines Rechenzeichens der Infixnotation zurück, 0 für Klammern und andere Zeichen.
+         */
+        static int getInfixRang( char c ) {
+            switch( c ) {
+                case '+':
+                case '-':
+                    return 1;
+                case '*':
+                case '/':
+                    return 2;
+                case 'n':
+                    return 3;
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+            @brief Gibt die Stellenzahl eines Rechenzeichens der Infixnotation für Fehlermeldungen zurück, 0 für Klammern und andere Zeichen.
+         */
+        static std::size_t getInfixStellen( char c ) {
+            return c == 'n' ? 1 : ( getInfixRang( c ) > 0 ? 2 : 0 );
+        }
+
+        /**
+            @brief Wendet ein Rechenzeichen der Infixnotation auf die obersten Zahlen des Stapels an.
+            Die Infixnotation braucht zu jedem Rechenzeichen seinen Rang und kennt deshalb nur die festen Rechenzeichen, nicht die der Operatortabelle.
+            @param c: '+', '-', '*', '/', 'k' (Kürzen) oder 'n' (Vorzeichenwechsel)
+            @returns ZuWenigZahlen, DivisionDurchNull oder KeinFehler
+            @throws Ueberlauf bei überlaufgeprüften Zahlen, NennerNull, wenn ein Nenner überläuft und 0 wird
+         */
+        Fehlercode rechne( char c ) {
+            const bool einstellig = c == 'k' || c == 'n';
+            if( hoehe < ( einstellig ? 1u : 2u ) )
+                return Fehlercode::ZuWenigZahlen;
+            Stoppuhr uhr( Phase::Rechnen );
+            if constexpr( instrumentiert ) {
+                zaehleRechenzeichen( std::string_view( &c, 1 ) );
+                erfasseBitbreite( stapel[hoehe - 1] );
+                if( !einstellig )
+                    erfasseBitbreite( stapel[hoehe - 2] );
+            }
+            switch( c ) {
+                case '+':
+                    hoehe--;
+                    stapel[hoehe - 1] = stapel[hoehe - 1] + stapel[hoehe];
+                    break;
+                case '-':
+                    hoehe--;
+                    stapel[hoehe - 1] = stapel[hoehe - 1] - stapel[hoehe];
+                    break;
+                case '*':
+                    hoehe--;
+                    stapel[hoehe - 1] = stapel[hoehe - 1] * stapel[hoehe];
+                    break;
+                case '/':
+                    if( stapel[hoehe - 1].getZaehler() == 0 )
+                        return Fehlercode::DivisionDurchNull;
+                    hoehe--;
+                    stapel[hoehe - 1] = stapel[hoehe - 1] / stapel[hoehe];
+                    break;
+                case 'n':
+                    stapel[hoehe - 1] = stapel[hoehe - 1] * -1;
+                    break;
+                default:
+                    stapel[hoehe - 1].kuerzeBruch();
+            }
+            return Fehlercode::KeinFehler;
+        }
+
+        /**
+            @brief Wendet ein Rechenzeichen der Operatortabelle auf die obersten Zahlen des Stapels an.
+            Eine Operation fester Stelligkeit N wird mit den obersten N Zahlen aufgerufen, ihr Ergebnis ersetzt sie. Eine Stapeloperation arbeitet selbst auf dem Stapel.
+            @arg F: Typ der Rechenoperation
+            @param eintrag: Der Eintrag der Operatortabelle
+            @returns Den Fehler der Operation oder KeinFehler
+            @throws Ueberlauf bei überlaufgeprüften Zahlen, NennerNull, wenn ein Nenner überläuft und 0 wird
+         */
+        template <typename F> Fehlercode wendeAn( const Operator<F>& eintrag ) {
+            if constexpr( IstStapeloperation<F, BruchTyp>::value ) {
+                Stoppuhr uhr( Phase::Rechnen );
+                if constexpr( instrumentiert )
+                    ::erfasseRechenzeichen( eintrag.name, stapel, hoehe, getStellen<BruchTyp>( eintrag ) );
+                return eintrag.operation( stapel, hoehe );
+            } else {
+                constexpr std::size_t stellen = Signatur<F>::stelligkeit;
+                if( hoehe < stellen )
+                    return Fehlercode::ZuWenigZahlen;
+                Stoppuhr uhr( Phase::Rechnen );
+                if constexpr( instrumentiert )
+                    ::erfasseRechenzeichen( eintrag.name, stapel, hoehe, stellen );
+                BruchTyp ergebnis = rufeAuf( eintrag.operation, std::make_index_sequence<stellen>() );
+                if constexpr( stellen == 0 )
+                    lege( std::move( ergebnis ) );
+                else {
+                    hoehe -= stellen - 1;
+                    stapel[hoehe - 1] = std::move( ergebnis );
+                }
+                return Fehlercode::KeinFehler;
+            }
+        }
+
+        /**
+            @brief Ruft operation mit den obersten sizeof...( I ) Zahlen des Stapels auf, die unterste zuerst.
+         */
+        template <typename F, std::size_t ... I> BruchTyp rufeAuf( const F& operation, std::index_sequence<I ...> ) {
+            return operation( stapel[hoehe - sizeof ...( I ) + I] ... );
+        }
+
+        /**
+            @brief Legt b oben auf den Stapel und vergrößert ihn, falls er voll ist.
+         */
+        void lege( BruchTyp&& b ) {
+            if( hoehe == kapazitaet ) {
+                std::vector<BruchTyp> neu( 2 * kapazitaet );
+                std::move( stapel, stapel + hoehe, neu.begin() );
+                grosserStapel = std::move( neu );
+                stapel = grosserStapel.data();
+                kapazitaet = grosserStapel.size();
+            }
+            stapel[hoehe++] = std::move( b );
+        }
+
+        BruchTyp puffer[Puffergroesse];
+        std::vector<BruchTyp> grosserStapel;
+        std::vector<Infixoperator> operatoren;
+        ///Zeigt auf puffer oder auf grosserStapel
+        BruchTyp* stapel;
+        std::size_t kapazitaet;
+        std::size_t hoehe;
+        ///Größte Stapeltiefe des Terms, nur für die Instrumentierung
+        std::size_t tiefste;
+        ///Stellenzahl des Rechenzeichens beim letzten ZuWenigZahlen, für die Fehlermeldung
+        std::size_t fehlerstellen;
+};
+
+#endif // TERMRECHNER_H
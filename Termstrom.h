@@ -0,0 +1,167 @@
+#ifndef TERMSTROM_H
+#define TERMSTROM_H
+
+#include <string>
+#include <string_view>
+#include <algorithm>
+
+#include "Bruch.h"
+#include "Termzerleger.h"
+#include "Termrechner.h"
+#include "Termergebnis.h"
+#include "Bruchoperatoren.h"
+
+/**
+    @brief Berechnet Terme, deren Text in Stücken beliebiger Größe ankommt.
+    Jede Zeile ist ein Term. Die Stücke werden mit lies übergeben und sofort verarbeitet, Zahlen und Rechenzeichen werden dabei wie im Termrechner berechnet.
+    Endet ein Stück mitten in einer Zahl (oder einem Minus oder dem Anfang eines längeren Rechenzeichens wie "sum"), wird nur dieser Rest behalten und vor das nächste Stück gesetzt.
+    Der Speicherbedarf hängt damit von der Stapeltiefe und der Länge der längsten Zahl ab, nicht von der Länge des Terms.
+    Ergebnisse und Fehlerpositionen entsprechen Termrechner::berechneOhneAusnahme für die ganze Zeile. Nach einem Fehler wird der Rest der Zeile überlesen.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg K: Kürzungsstrategie für die Zwischenergebnisse
+    @arg Operatoren: Typ mit der Operatortabelle als Konstante tabelle, wie beim Termrechner
+ */
+template <typename T, typename K = KuerzeNie, typename Operatoren = Bruchoperatoren<Bruch<T, K>>> class Termstrom {
+    public:
+        using BruchTyp = Bruch<T, K>;
+
+        Termstrom()
+            : termlaenge( 0 ), fehlerhaft( false ), fehlerzeichen( 0 ) {
+            rechner.beginne();
+        }
+
+        /**
+            @brief Verarbeitet das nächste Stück der Eingabe.
+            Für jeden Zeilenumbruch im Stück wird der Term der Zeile abgeschlossen und beiErgebnis mit dem Ergebnis aufgerufen.
+            @arg F: Funktion mit dem Parameter const Termergebnis<BruchTyp>&
+            @param stueck: Das Stück, es muss nur während des Aufrufs gültig bleiben
+            @param beiErgebnis: Wird für jeden fertigen Term aufgerufen
+         */
+        template <typename F> void lies( std::string_view stueck, F&& beiErgebnis ) {
+            if( !rest.empty() ) {
+                ///Der Rest wird nur bis zum ersten whitespace char ergänzt, dort ist sein Token sicher zu Ende. Der übrige Teil des Stücks wird ohne Kopie verarbeitet.
+                std::size_t laenge = 0;
+                while( laenge < stueck.size() && !istLeerzeichen( stueck[laenge] ) )
+                    laenge++;
+                laenge = std::min( laenge + 1, stueck.size() );
+                rest.append( stueck.data(), laenge );
+                stueck.remove_prefix( laenge );
+                const std::size_t gelesen = verarbeite( rest, beiErgebnis );
+                rest.erase( 0, gelesen );
+                if( !rest.empty() ) {
+                    rest.append( stueck.data(), stueck.size() );
+                    return;
+                }
+            }
+            const std::size_t gelesen = verarbeite( stueck, beiErgebnis );
+            rest.assign( stueck.data() + gelesen, stueck.size() - gelesen );
+        }
+
+        /**
+            @brief Schließt die Eingabe ab.
+            Enthält die letzte Zeile Zeichen, aber keinen Zeilenumbruch, wird ihr Term abgeschlossen und beiErgebnis aufgerufen. Danach kann eine neue Eingabe beginnen.
+         */
+        template <typename F> void beende( F&& beiErgebnis ) {
+            if( rest.empty() && termlaenge == 0 )
+                return;
+            const std::string letzte = std::move( rest );
+            rest.clear();
+            verarbeiteZeile( letzte, true );
+            schliesseTermAb( beiErgebnis );
+        }
+
+        /**
+            @brief Hängt die Fehlermeldung zum Fehler des zuletzt gemeldeten Terms an text an.
+            Der Term liegt nicht mehr im Speicher, deshalb wird das Zeichen an der Fehlerposition beim Fehler aufbewahrt.
+            @param text: Die Zeichenkette, an die angehängt wird
+            @param fehler: Der Fehlercode aus dem Termergebnis
+         */
+        void haengeFehlermeldungAn( std::string& text, Fehlercode fehler ) const {
+            ::haengeFehlermeldungAn( text, fehler, std::string_view( &fehlerzeichen, 1 ), 0, ergebnis.stellen );
+        }
+
+        /**
+            @brief Gibt die Anzahl der Zeichen zurück, die zwischen zwei Stücken behalten werden.
+         */
+        std::size_t getRestlaenge() const {
+            return rest.size();
+        }
+
+    private:
+        static bool istLeerzeichen( char c ) {
+            return c == ' ' || ( c >= '\t' && c <= '\r' );
+        }
+
+        /**
+            @brief Verarbeitet text bis auf ein unvollständiges Token am Ende.
+            @returns Anzahl der verarbeiteten Zeichen
+         */
+        template <typename F> std::size_t verarbeite( std::string_view text, F& beiErgebnis ) {
+            std::size_t anfang = 0;
+            for( ;; ) {
+                const std::size_t umbruch = text.find( '\n', anfang );
+                if( umbruch == std::string_view::npos )
+                    return anfang + verarbeiteZeile( text.substr( anfang ), false );
+                verarbeiteZeile( text.substr( anfang, umbruch - anfang ), true );
+                schliesseTermAb( beiErgebnis );
+                anfang = umbruch + 1;
+            }
+        }
+
+        /**
+            @brief Verarbeitet ein Stück einer Zeile.
+            @param zeile: Das Stück, es enthält keinen Zeilenumbruch
+            @param zeilenende: True, wenn die Zeile nach dem Stück endet. Sonst wird ein Token am Ende des Stücks erst verarbeitet, wenn es abgeschlossen ist.
+            @returns Anzahl der verarbeiteten Zeichen
+         */
+        std::size_t verarbeiteZeile( std::string_view zeile, bool zeilenende ) {
+            if( fehlerhaft ) {
+                termlaenge += zeile.size();
+                return zeile.size();
+            }
+            ///Ein Token kann keinen whitespace char enthalten. Was vor dem letzten whitespace char beginnt, ist also abgeschlossen und muss nicht geprüft werden.
+            const std::size_t letztesLeerzeichen = zeile.find_last_of( " \t\n\v\f\r" );
+            Termzerleger zerleger( zeile );
+            while( zerleger.ueberspringeLeerzeichen() ) {
+                const std::size_t anfang = zerleger.getPosition();
+                if( !zeilenende && ( letztesLeerzeichen == std::string_view::npos || anfang > letztesLeerzeichen )
+                    && ( !zerleger.naechstesIstAbgeschlossen() || Operatoren::tabelle.istNamensanfang( zerleger.getRest() ) ) ) {
+                    termlaenge += anfang;
+                    return anfang;
+                }
+                const Fehlercode fehler = rechner.verarbeite( zerleger );
+                if( fehler != Fehlercode::KeinFehler ) {
+                    fehlerhaft = true;
+                    ergebnis = { BruchTyp(), fehler, termlaenge + anfang, rechner.getFehlerstellen() };
+                    fehlerzeichen = zeile[anfang];
+                    termlaenge += zeile.size();
+                    return zeile.size();
+                }
+            }
+            termlaenge += zeile.size();
+            return zeile.size();
+        }
+
+        /**
+            @brief Meldet das Ergebnis des aktuellen Terms und beginnt den nächsten.
+         */
+        template <typename F> void schliesseTermAb( F& beiErgebnis ) {
+            if( !fehlerhaft )
+                ergebnis = rechner.beende( termlaenge );
+            beiErgebnis( static_cast<const Termergebnis<BruchTyp>&>( ergebnis ) );
+            rechner.beginne();
+            termlaenge = 0;
+            fehlerhaft = false;
+        }
+
+        Termrechner<T, K, 16, Operatoren> rechner;
+        ///Unvollständiges Token am Ende des letzten Stücks
+        std::string rest;
+        ///Bisher verarbeitete Zeichen des aktuellen Terms, für die Fehlerpositionen
+        std::size_t termlaenge;
+        bool fehlerhaft;
+        Termergebnis<BruchTyp> ergebnis;
+        char fehlerzeichen;
+};
+
+#endif // TERMSTROM_H
@@ -0,0 +1,107 @@
+#include "Termzerleger.h"
+
+#include <utility>
+
+/**
+    @brief Prüft, ob c ein whitespace char der "C"-locale ist.
+ */
+static bool istLeerzeichen( char c ) {
+    return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+/**
+    @brief Prüft, ob c eine Ziffer ist.
+ */
+static bool istZiffer( char c ) {
+    return c >= '0' && c <= '9';
+}
+
+bool Termzerleger::ueberspringeLeerzeichen() {
+    while( position < text.size() && istLeerzeichen( text[position] ) )
+        position++;
+    return position < text.size();
+}
+
+bool Termzerleger::naechsteIstZahl() const {
+    if( position >= text.size() )
+        return false;
+    ///Prüft, ob die nächste Zeichenkette eine Ziffer oder ein Minus mit direkt folgender Ziffer ist.
+    if( istZiffer( text[position] ) )
+        return true;
+    return text[position] == '-' && position + 1 < text.size() && istZiffer( text[position + 1] );
+}
+
+/**
+    @brief Gibt die Position hinter den Ziffern ab position zurück.
+ */
+static std::size_t ueberspringeZiffern( std::string_view text, std::size_t position ) {
+    while( position < text.size() && istZiffer( text[position] ) )
+        position++;
+    return position;
+}
+
+bool Termzerleger::naechstesIstAbgeschlossen() const {
+    ///Ein Minus am Ende kann Rechenzeichen oder Vorzeichen sein.
+    std::size_t ende = position + ( text[position] == '-' );
+    if( ende == text.size() )
+        return false;
+    if( istZiffer( text[ende] ) ) {
+        ende = ueberspringeZiffern( text, ende );
+        if( ende == text.size() )
+            return false;
+        if( text[ende] != '/' )
+            return true;
+        ende++;
+        if( ende < text.size() && text[ende] == '-' )
+            ende++;
+        return ueberspringeZiffern( text, ende ) < text.size();
+    }
+    return true;
+}
+
+/**
+    @brief Prüft, ob c in einem Namen vorkommen darf.
+ */
+static bool istNamenszeichen( char c ) {
+    return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || c == '_' || istZiffer( c );
+}
+
+std::string_view Termzerleger::naechsterName() const {
+    if( position >= text.size() || !istNamenszeichen( text[position] ) || istZiffer( text[position] ) )
+        return std::string_view();
+    std::size_t ende = position + 1;
+    while( ende < text.size() && istNamenszeichen( text[ende] ) )
+        ende++;
+    return text.substr( position, ende - position );
+}
+
+char Termzerleger::leseReduktion() {
+    static const std::pair<std::string_view, char> rechenzeichen[] = { { "Σ", '+' }, { "sum", '+' }, { "Π", '*' }, { "prod", '*' } };
+    const std::string_view rest = text.substr( position );
+    for( const auto& [name, reduktion] : rechenzeichen )
+        if( rest.substr( 0, name.size() ) == name ) {
+            position += name.size();
+            return reduktion;
+        }
+    return 0;
+}
+
+const char* leseZahl( const char* anfang, const char* ende, Langzahl& zahl ) {
+    const bool negativ = anfang != ende && *anfang == '-';
+    const char* zeiger = anfang + negativ;
+    Langzahl betrag;
+    ///Je 18 Ziffern passen in 64 Bit und werden auf einmal in die Langzahl übernommen. Kleine Zahlen kommen so ohne Ziffernfolge aus.
+    while( zeiger != ende && istZiffer( *zeiger ) ) {
+        std::uint64_t block = 0;
+        std::uint64_t stellenwert = 1;
+        for( int i = 0; i < 18 && zeiger != ende && istZiffer( *zeiger ); i++, zeiger++ ) {
+            block = block * 10 + ( *zeiger - '0' );
+            stellenwert *= 10;
+        }
+        betrag = betrag == 0 ? Langzahl( block ) : betrag * Langzahl( stellenwert ) + Langzahl( block );
+    }
+    if( zeiger == anfang + negativ )
+        return anfang;
+    zahl = negativ ? -betrag : betrag;
+    return zeiger;
+}
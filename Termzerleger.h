@@ -0,0 +1,257 @@
+#ifndef TERMZERLEGER_H
+#define TERMZERLEGER_H
+
+#include <string_view>
+#include <charconv>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Bruch.h"
+#include "Geprueft.h"
+#include "Langzahl.h"
+#include "Termergebnis.h"
+
+/**
+    @brief Liest eine Zahl aus dem Zeichenbereich [anfang, ende), ohne Exceptions zu werfen.
+    Für eingebaute Ganzzahl- und Gleitkommatypen wird std::from_chars genutzt. Wie beim Einlesen über einen std::istream werden negative Zahlen auch für vorzeichenlose Typen akzeptiert und modulo 2^n abgebildet.
+    @arg T: Zahlentyp
+    @param anfang: Erstes Zeichen der Zahl
+    @param ende: Ende des Zeichenbereichs
+    @param zahl: Die eingelesene Zahl
+    @returns Zeiger auf das erste Zeichen nach der Zahl; errc::invalid_argument, falls keine Zahl gefunden wurde, errc::result_out_of_range, falls die Zahl nicht in T passt
+ */
+template <typename T> std::from_chars_result zerlegeZahl( const char* anfang, const char* ende, T& zahl ) {
+    if constexpr( std::is_floating_point<T>::value || std::is_signed<T>::value ) {
+        return std::from_chars( anfang, ende, zahl );
+    } else if constexpr( std::is_integral<T>::value ) {
+        const bool negativ = anfang != ende && *anfang == '-';
+        const auto ergebnis = std::from_chars( anfang + negativ, ende, zahl );
+        if( ergebnis.ec != std::errc() )
+            return { anfang, ergebnis.ec };
+        if( negativ )
+            zahl = static_cast<T>( -zahl );
+        return ergebnis;
+    } else {
+        ///__int128 kennt std::from_chars im strikten C++17-Modus nicht.
+        static_assert( std::is_same<T, __int128>::value, "Für diesen Zahlentyp ist kein leseZahl definiert." );
+        const bool negativ = anfang != ende && *anfang == '-';
+        const char* zeiger = anfang + negativ;
+        unsigned __int128 betrag = 0;
+        const unsigned __int128 grenze = ( ~static_cast<unsigned __int128>( 0 ) >> 1 ) + negativ;
+        for( ; zeiger != ende && *zeiger >= '0' && *zeiger <= '9'; zeiger++ ) {
+            const unsigned ziffer = *zeiger - '0';
+            if( betrag > ( grenze - ziffer ) / 10 )
+                return { anfang, std::errc::result_out_of_range };
+            betrag = betrag * 10 + ziffer;
+        }
+        if( zeiger == anfang + negativ )
+            return { anfang, std::errc::invalid_argument };
+        zahl = negativ ? static_cast<__int128>( -betrag ) : static_cast<__int128>( betrag );
+        return { zeiger, std::errc() };
+    }
+}
+
+/**
+    @brief Liest eine überlaufgeprüfte Zahl aus dem Zeichenbereich [anfang, ende), ohne Exceptions zu werfen.
+    @arg T: verpackter Ganzzahltyp
+ */
+template <typename T> std::from_chars_result zerlegeZahl( const char* anfang, const char* ende, Geprueft<T>& zahl ) {
+    T wert;
+    const auto ergebnis = zerlegeZahl( anfang, ende, wert );
+    if( ergebnis.ec == std::errc() )
+        zahl = wert;
+    return ergebnis;
+}
+
+/**
+    @brief Liest eine Langzahl aus dem Zeichenbereich [anfang, ende).
+    @returns Zeiger auf das erste Zeichen nach der Zahl, anfang falls keine Zahl gefunden wurde
+ */
+const char* leseZahl( const char* anfang, const char* ende, Langzahl& zahl );
+
+/**
+    @brief Liest eine Langzahl aus dem Zeichenbereich [anfang, ende). Eine Langzahl läuft nie über.
+ */
+inline std::from_chars_result zerlegeZahl( const char* anfang, const char* ende, Langzahl& zahl ) {
+    const char* zeiger = leseZahl( anfang, ende, zahl );
+    return { zeiger, zeiger == anfang ? std::errc::invalid_argument : std::errc() };
+}
+
+/**
+    @brief Liest eine Zahl aus dem Zeichenbereich [anfang, ende).
+    Die Funktion arbeitet wie zerlegeZahl, meldet einen Überlauf aber als Exception.
+    @arg T: Zahlentyp
+    @param anfang: Erstes Zeichen der Zahl
+    @param ende: Ende des Zeichenbereichs
+    @param zahl: Die eingelesene Zahl
+    @returns Zeiger auf das erste Zeichen nach der Zahl, anfang falls keine Zahl gefunden wurde
+    @throws Ueberlauf, falls die Zahl nicht in T passt
+ */
+template <typename T> const char* leseZahl( const char* anfang, const char* ende, T& zahl ) {
+    const auto [zeiger, fehler] = zerlegeZahl( anfang, ende, zahl );
+    if( fehler == std::errc::result_out_of_range )
+        throw Ueberlauf();
+    return fehler == std::errc() ? zeiger : anfang;
+}
+
+/**
+    @brief Zerlegt einen Term ohne Kopieren in Zahlen und Rechenzeichen.
+    Der Termzerleger arbeitet direkt auf dem übergebenen Text und ersetzt für Zeichenketten die Funktionen clearWhitespacesCharFound, naechsteIstZahl und den Operator >> für Brüche.
+    Er folgt derselben Grammatik und wirft dieselben Fehlermeldungen, benötigt aber keine get/putback-Aufrufe und keine locale.
+    Der Text muss gültig bleiben, solange der Termzerleger genutzt wird.
+ */
+class Termzerleger {
+    public:
+        /**
+            @brief Konstruktor: Beginnt am Anfang von text.
+            @param text: Der zu zerlegende Term
+         */
+        explicit Termzerleger( std::string_view text )
+            : text( text ), position( 0 ) {
+        }
+
+        /**
+            @brief Überspringt alle whitespace chars bis zum nächsten Zeichen.
+            @returns True, wenn danach noch ein Zeichen vorhanden ist
+         */
+        bool ueberspringeLeerzeichen();
+
+        /**
+            @brief Testet, ob an der aktuellen Position eine Zahl beginnt.
+            Eine Zahl beginnt mit einer Ziffer oder mit einem Minus, auf das direkt eine Ziffer folgt. Whitespace chars werden nicht übersprungen.
+            @returns True, wenn eine Zahl gefunden wurde
+         */
+        bool naechsteIstZahl() const;
+
+        /**
+            @brief Testet, ob die Zahl oder das Rechenzeichen an der aktuellen Position vor dem Ende des Texts abgeschlossen ist.
+            Ist der Text nur ein Stück eines längeren Terms, kann eine Zahl oder ein Minus im nächsten Stück weitergehen.
+            Abgeschlossen ist eine Zahl erst, wenn nach ihr noch ein Zeichen folgt, das nicht mehr zu ihr gehört.
+            Ob ein Rechenzeichen im nächsten Stück weitergeht, hängt von der Operatortabelle ab und wird hier nicht geprüft (siehe Operatortabelle::istNamensanfang).
+            @returns False, wenn der Rest des Texts mit dem nächsten Stück noch anders gelesen werden kann
+            @pre Es ist noch ein Zeichen vorhanden
+         */
+        bool naechstesIstAbgeschlossen() const;
+
+        /**
+            @brief Liest das nächste Zeichen.
+            @returns Das Zeichen
+            @pre Es ist noch ein Zeichen vorhanden
+         */
+        char leseZeichen() {
+            return text[position++];
+        }
+
+        /**
+            @brief Gibt den Namen an der aktuellen Position zurück, ohne ihn zu lesen.
+            Ein Name beginnt mit einem Buchstaben oder "_" und besteht aus Buchstaben, Ziffern und "_".
+            @returns Der Name oder eine leere Zeichenkette, wenn an der aktuellen Position kein Name beginnt
+         */
+        std::string_view naechsterName() const;
+
+        /**
+            @brief Liest ein n-stelliges Rechenzeichen, falls eines an der aktuellen Position steht.
+            Die Summe wird als "Σ" oder "sum" geschrieben, das Produkt als "Π" oder "prod". Wie in der Operatortabelle von berechneNaechstenTerm genügt es, dass der Text mit dem Namen beginnt.
+            @returns '+' für die Summe, '*' für das Produkt, 0 wenn kein n-stelliges Rechenzeichen folgt (dann wird nichts gelesen)
+         */
+        char leseReduktion();
+
+        /**
+            @brief Rückt um anzahl Zeichen vor.
+            @param anzahl: Anzahl der zu überspringenden Zeichen
+            @pre Es sind noch mindestens anzahl Zeichen vorhanden
+         */
+        void ueberspringe( std::size_t anzahl ) {
+            position += anzahl;
+        }
+
+        /**
+            @brief Gibt den noch nicht gelesenen Rest des Texts zurück.
+         */
+        std::string_view getRest() const {
+            return text.substr( position );
+        }
+
+        /**
+            @brief Gibt die aktuelle Position im Text zurück.
+            @returns Index des nächsten ungelesenen Zeichens
+         */
+        std::size_t getPosition() const {
+            return position;
+        }
+
+        /**
+            @brief Liest einen Bruch.
+            Sollte direkt nach dem Zähler kein Bruchstrich ("/") kommen, wird die Zahl als Ganzzahl interpretiert und 1 in den Nenner geschrieben.
+            @arg T: Datentyp von Zähler und Nenner des Bruchs
+            @arg K: Kürzungsstrategie des Bruchs
+            @returns Der gelesene Bruch
+            @pre Die nächste Zeichenkette ist ein Bruch mit dem Format "[Zähler]/[Nenner]" oder "[Zähler]"
+         */
+        template <typename T, typename K> Bruch<T, K> leseBruch() {
+            if( !ueberspringeLeerzeichen() )
+                throw std::logic_error( "Der gegebene Inputstream ist leer." );
+            if( !naechsteIstZahl() )
+                throw std::logic_error( "Der Ausdruck beginnt nicht mit einer Zahl, obwohl ein Bruch erwartet wird." );
+            Bruch<T, K> b;
+            const Fehlercode fehler = leseBruchOhneAusnahme( b );
+            if( fehler != Fehlercode::KeinFehler )
+                wirfFehler( fehler, text, position );
+            return b;
+        }
+
+        /**
+            @brief Liest einen Bruch, ohne Exceptions zu werfen.
+            @arg T: Datentyp von Zähler und Nenner des Bruchs
+            @arg K: Kürzungsstrategie des Bruchs
+            @param b: Der gelesene Bruch, bei einem Fehler unverändert
+            @param bruchstrichAlsRechenzeichen: True für Infixterme: Folgt auf den Bruchstrich keine Zahl (z.B. "1/(2 + 3)"), wird er nicht gelesen und bleibt als Division stehen
+            @returns NennerFehlt, DivisionDurchNull (Nenner 0), Ueberlauf oder KeinFehler
+            @pre naechsteIstZahl()
+         */
+        template <typename T, typename K> Fehlercode leseBruchOhneAusnahme( Bruch<T, K>& b, bool bruchstrichAlsRechenzeichen = false ) {
+            T zaehler( 0 );
+            if( !leseNaechsteZahl( zaehler ) )
+                return Fehlercode::Ueberlauf;
+            ///Falls auf den Zähler ein Bruchstrich folgt, wird der Nenner ausgelesen. Ansonsten wird die Zahl als Ganze Zahl interpretiert.
+            if( position < text.size() && text[position] == '/' ) {
+                position++;
+                if( !naechsteIstZahl() && bruchstrichAlsRechenzeichen ) {
+                    position--;
+                    b = Bruch<T, K>( zaehler );
+                    return Fehlercode::KeinFehler;
+                }
+                if( !naechsteIstZahl() )
+                    return Fehlercode::NennerFehlt;
+                T nenner( 0 );
+                if( !leseNaechsteZahl( nenner ) )
+                    return Fehlercode::Ueberlauf;
+                if( nenner == 0 )
+                    return Fehlercode::DivisionDurchNull;
+                b = Bruch<T, K>( nenner, zaehler );
+            } else
+                b = Bruch<T, K>( zaehler );
+            return Fehlercode::KeinFehler;
+        }
+
+    private:
+        /**
+            @brief Liest die Zahl an der aktuellen Position und rückt hinter sie vor.
+            @returns False, wenn die Zahl nicht in T passt
+            @pre naechsteIstZahl()
+         */
+        template <typename T> bool leseNaechsteZahl( T& zahl ) {
+            const char* anfang = text.data() + position;
+            const auto [zeiger, fehler] = zerlegeZahl( anfang, text.data() + text.size(), zahl );
+            if( fehler == std::errc::result_out_of_range )
+                return false;
+            if( fehler == std::errc() )
+                position += zeiger - anfang;
+            return true;
+        }
+
+        std::string_view text;
+        std::size_t position;
+};
+
+#endif // TERMZERLEGER_H
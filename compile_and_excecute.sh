@@ -1,7 +1,8 @@
 std=c++17
 printf "\e[1;31m >> Compiling : \e[0m \n"
-g++ mainTest.cpp  Bruchberechner.cpp Berechner.cpp Bruch.cpp -o BruchrechnerTest -std=$std -Wall -I include
-g++ main.cpp  Bruchberechner.cpp Berechner.cpp Bruch.cpp -o Bruchrechner -std=$std -Wall -I include
+g++ mainTest.cpp  Bruchberechner.cpp Berechner.cpp Bruch.cpp Geprueft.cpp Langzahl.cpp Termzerleger.cpp Stapelverarbeitung.cpp Ausgabe.cpp Termergebnis.cpp Instrumentierung.cpp Arbeitspool.cpp Modularrechner.cpp Ergebniscache.cpp -o BruchrechnerTest -std=$std -Wall -pthread -I include
+g++ main.cpp  Bruchberechner.cpp Berechner.cpp Bruch.cpp Geprueft.cpp Langzahl.cpp Termzerleger.cpp Stapelverarbeitung.cpp Ausgabe.cpp Termergebnis.cpp Instrumentierung.cpp Arbeitspool.cpp Modularrechner.cpp Ergebniscache.cpp -o Bruchrechner -std=$std -Wall -pthread -I include
+g++ mainBenchmark.cpp  Bruchberechner.cpp Berechner.cpp Bruch.cpp Geprueft.cpp Langzahl.cpp Termzerleger.cpp Stapelverarbeitung.cpp Ausgabe.cpp Termergebnis.cpp Instrumentierung.cpp Arbeitspool.cpp Modularrechner.cpp Ergebniscache.cpp -o BruchrechnerBenchmark -std=$std -Wall -O2 -pthread -I include
 printf "\e[1;31m >> Done. Testing: \e[0m \n"
 ./BruchrechnerTest
 printf "\e[1;31m >> Done. Executing Bruchrechner: \e[0m \n"
@@ -6,30 +6,137 @@
 #include <sstream>
 #include <string>
 #include <stdexcept>
+#include <csignal>
+#include <memory>
+#include <charconv>
+#include <cstring>
+
+#include <unistd.h>
 
 #include "Bruchberechner.h"
+#include "Stapelverarbeitung.h"
+#include "Ausgabe.h"
+#include "Instrumentierung.h"
+#include "Ergebniscache.h"
+
+/**
+    @brief Liest den Zahlenwert einer Option.
+    @param text: Der Wert, wie er auf der Kommandozeile steht
+    @param minimum: Der kleinste zulässige Wert
+    @param maximum: Der größte zulässige Wert
+    @param zahl: Der gelesene Wert, wird nur bei Erfolg geschrieben
+    @returns False, wenn text keine Dezimalzahl ist oder außerhalb von [minimum, maximum] liegt
+ */
+static bool liesOptionswert( const char* text, unsigned long minimum, unsigned long maximum, unsigned long& zahl ) {
+    const char* ende = text + std::strlen( text );
+    unsigned long wert = 0;
+    const auto [position, fehler] = std::from_chars( text, ende, wert );
+    if( fehler != std::errc() || position != ende || wert < minimum || wert > maximum )
+        return false;
+    zahl = wert;
+    return true;
+}
 
 /**
     @brief Errechnet das Ergebnis aus der Eingabe.
     Die Main-Funktion liest die, durch den*die Nutzer*in eingegebenen Terme zeilenweise ein, errechnet das Ergebnis und gibt es über die Konsole aus.
     Im Fall einer Exception wird der Fehler ausgegeben und der*die Nutzer*in kann eine erneute Eingabe tätigen.
+    Die Ausgabe wird gepuffert und nur bei interaktiver Nutzung (Konsole an Ein- oder Ausgabe) nach jeder Zeile geschrieben. Wird aus einer Datei oder Pipe gelesen und in eine geschrieben, entfällt der Systemaufruf pro Zeile.
+    Optionen:
+    - "--geprueft": Die Terme werden mit Überlaufprüfung berechnet. Läuft long int über, wird automatisch mit einem breiteren Datentyp weitergerechnet.
+    - "--datei [Pfad]": Stapelverarbeitung. Statt von der Konsole werden alle Zeilen der Datei auf mehreren Threads berechnet und in Eingabereihenfolge ausgegeben.
+    - "--threads [Anzahl]": Anzahl der Arbeitsthreads für die Stapelverarbeitung, 1 bis 1024, default = Anzahl der Prozessorkerne
+    - "--infix": Die Terme stehen in Infixnotation, z.B. "(1/2 + 3/4) * -5/6", und werden ohne Umweg über Postfixnotation berechnet. Nicht mit "--strom" kombinierbar.
+    - "--cache [MiB]": Die Ergebnisse werden in einem Ergebniscache mit höchstens MiB Megabyte (1 bis 2^20) gespeichert, wiederholte Terme werden nicht erneut berechnet.
+      Terme, die sich nur im Leerraum unterscheiden, gelten als gleich. Beim Programmende werden Treffer und Fehlgriffe nach std::cerr geschrieben. Nicht mit "--strom" kombinierbar.
+    - "--strom": Die Eingabe wird blockweise gelesen und mit einem Termstrom berechnet, ohne eine Zeile vollständig im Speicher zu halten. Für Terme, die zu lang für eine Zeile im Speicher sind.
+    Wurde mit -DBRUCHRECHNER_INSTRUMENTIERUNG übersetzt, wird beim Programmende eine Zusammenfassung der Messwerte nach std::cerr geschrieben.
+    Im interaktiven Modus kann sie zusätzlich mit SIGUSR1 angefordert werden, sie erscheint dann nach der nächsten Zeile.
  */
-int main() {
-    while( std::cin ) {
-        std::string str;
+int main( int argc, char* argv[] ) {
+    bool geprueft = false;
+    bool strom = false;
+    bool infix = false;
+    std::string datei;
+    unsigned threads = 0;
+    std::unique_ptr<Ergebniscache> cache;
+    for( int i = 1; i < argc; i++ ) {
+        const std::string option( argv[i] );
+        if( option == "--geprueft" )
+            geprueft = true;
+        else if( option == "--datei" && i + 1 < argc )
+            datei = argv[++i];
+        else if( option == "--infix" )
+            infix = true;
+        else if( option == "--strom" )
+            strom = true;
+        else if( option == "--cache" && i + 1 < argc ) {
+            unsigned long megabyte;
+            if( !liesOptionswert( argv[++i], 1, 1 << 20, megabyte ) ) {
+                std::cerr << "Ungültiger Wert für --cache: " << argv[i] << " (erlaubt sind 1 bis 1048576 MiB)\n";
+                return 1;
+            }
+            cache = std::make_unique<Ergebniscache>( static_cast<std::size_t>( megabyte ) << 20 );
+        } else if( option == "--threads" && i + 1 < argc ) {
+            unsigned long anzahl;
+            if( !liesOptionswert( argv[++i], 1, 1024, anzahl ) ) {
+                std::cerr << "Ungültiger Wert für --threads: " << argv[i] << " (erlaubt sind 1 bis 1024)\n";
+                return 1;
+            }
+            threads = anzahl;
+        } else {
+            std::cerr << "Unbekannte Option: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    if( strom && ( infix || cache ) ) {
+        std::cerr << "Die Option --strom kann nicht mit --infix oder --cache kombiniert werden.\n";
+        return 1;
+    }
+    auto schreibeCachebericht = [&cache]() {
+        if( cache )
+            std::cerr << "Ergebniscache: " << cache->getTreffer() << " Treffer, " << cache->getFehlgriffe() << " Fehlgriffe, "
+                      << cache->getVerdraengt() << " verdrängt, " << cache->getAnzahl() << " Einträge mit " << cache->getBelegt() << " Byte\n";
+    };
+    if constexpr( instrumentiert )
+        aktiviereZusammenfassung( SIGUSR1 );
+    if( !datei.empty() ) {
         try {
-            std::getline( std::cin, str );
-            std::istringstream term( str );
-            auto i = berechneNaechstenTerm<long int>( term );
-            std::cout << i << "\n" << std::endl;
-        } catch( const std::runtime_error& e ) {
-            std::cout << "Bei der Berechnung ist ein Fehler aufgetreten:\n";
-            std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            Ausgabepuffer ausgabe( STDOUT_FILENO );
+            berechneDatei( datei, ausgabe, threads, geprueft, infix, cache.get() );
         } catch( const std::exception& e ) {
-            std::cout << "Bei der Berechnung ist ein unerwarteter Fehler aufgetreten:\n";
-            std::cout <<  "\"" << e.what() << "\"\n" << std::endl;
+            std::cerr << e.what() << "\n";
+            return 1;
         }
+        schreibeCachebericht();
+        return 0;
     }
+    if( strom ) {
+        try {
+            Ausgabepuffer ausgabe( STDOUT_FILENO, isatty( STDIN_FILENO ) || isatty( STDOUT_FILENO ) );
+            berechneStrom( STDIN_FILENO, ausgabe, geprueft );
+        } catch( const std::exception& e ) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    std::ios::sync_with_stdio( false );
+    Ausgabepuffer ausgabe( STDOUT_FILENO, isatty( STDIN_FILENO ) || isatty( STDOUT_FILENO ) );
+    ///Eingabe- und Ausgabezeile werden wiederverwendet, damit pro Zeile kein Speicher angefordert werden muss.
+    std::string str;
+    std::string ergebnis;
+    while( std::cin ) {
+        str.clear();                                    //getline leert str nicht, wenn das Ende der Eingabe schon erreicht ist.
+        std::getline( std::cin, str );
+        ergebnis.clear();
+        berechneZeile( str, ergebnis, geprueft, infix, cache.get() );
+        ausgabe.schreibe( ergebnis );
+        ausgabe.zeileFertig();
+        if constexpr( instrumentiert )
+            if( zusammenfassungAngefordert() )
+                schreibeZusammenfassung( std::cerr );
+    }
+    ausgabe.leere();
+    schreibeCachebericht();
 }
-
-
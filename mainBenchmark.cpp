@@ -0,0 +1,771 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <utility>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <memory>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Bruchberechner.h"
+#include "Stapelverarbeitung.h"
+#include "Ausgabe.h"
+#include "Termprogramm.h"
+#include "Termgraph.h"
+#include "Bruchsortierung.h"
+#include "Bruchspalte.h"
+#include "Baumreduktion.h"
+#include "Modularrechner.h"
+#include "Termstrom.h"
+#include "Ergebniscache.h"
+
+///Prototypes
+unsigned long int ggtRekursiv( const unsigned long int&, const unsigned long int& );
+template <typename F> void messe( const std::string&, std::size_t, F, const char* einheit = "op" );
+std::vector<std::string> erzeugeTerme( std::mt19937_64&, char, std::size_t, std::size_t );
+template <typename T> void messeDatentyp( std::mt19937_64&, const std::string& );
+template <typename T> std::vector<Bruch<T>> erzeugeBrueche( std::mt19937_64&, std::size_t, int );
+template <typename T> bool istBerechenbar( const std::string& );
+template <typename Kuerzung> void messeKuerzung( const std::string&, const std::vector<std::string>& );
+template <typename T, typename Kuerzung> void messeGemeinsamenNenner( const std::string& );
+Bruch<long int> berechneMitVektor( std::string_view );
+std::string zuInfix( std::string_view );
+
+///Verhindert, dass der Compiler die gemessenen Berechnungen wegoptimiert.
+volatile unsigned long int senke = 0;
+
+///Es werden nur Messungen ausgeführt, deren Name diese Zeichenkette enthält.
+std::string filter;
+
+/**
+    @brief Erzeugt zufällige Terme in Postfixnotation mit einstellbarer Form.
+    Jeder Term ist ein zufälliger Rechenbaum, dessen längster Ast genau tiefe Rechenzeichen enthält. Ein Term hat also höchstens 2^tiefe Zahlen.
+ */
+struct Termgenerator {
+    ///Name der Einstellung für die Namen der Messungen
+    std::string name;
+    std::size_t tiefe;
+    ///Gewichte der Rechenzeichen + - * /
+    std::array<unsigned, 4> mischung;
+    ///Wahrscheinlichkeit, mit der ein Zwischenergebnis gekürzt wird (k)
+    double kuerzen;
+    ///Zähler und Nenner liegen zwischen 1 und groesse.
+    unsigned long int groesse;
+
+    std::string erzeuge( std::mt19937_64& zufall ) const {
+        std::string term;
+        erzeugeBaum( zufall, tiefe, term );
+        return term;
+    }
+
+    private:
+        void erzeugeBaum( std::mt19937_64& zufall, std::size_t rest, std::string& term ) const {
+            if( rest == 0 ) {
+                term += std::to_string( 1 + zufall() % groesse ) + "/" + std::to_string( 1 + zufall() % groesse ) + " ";
+                return;
+            }
+            ///Einer der beiden Teilbäume bestimmt die Tiefe, der andere ist zufällig flacher.
+            const std::size_t flach = zufall() % rest;
+            const bool linksTief = zufall() % 2 == 0;
+            erzeugeBaum( zufall, linksTief ? rest - 1 : flach, term );
+            erzeugeBaum( zufall, linksTief ? flach : rest - 1, term );
+            unsigned wahl = zufall() % ( mischung[0] + mischung[1] + mischung[2] + mischung[3] );
+            std::size_t i = 0;
+            while( mischung[i] <= wahl )
+                wahl -= mischung[i++];
+            term += "+-*/"[i];
+            term += " ";
+            if( std::generate_canonical<double, 32>( zufall ) < kuerzen )
+                term += "k ";
+        }
+};
+
+/**
+    @brief Misst die Laufzeit der Bausteine des Bruchrechners.
+    Die Ergebnisse werden als CSV mit Kopfzeile ausgegeben, eine Zeile je Messung: Name, Einheit (op oder term), Nanosekunden pro Einheit und Einheiten pro Sekunde.
+    Als erstes Argument kann ein Filter übergeben werden, dann laufen nur die Messungen, deren Name ihn enthält (z.B. "term/long").
+    Das Programm sollte mit Optimierung (-O2) übersetzt werden, sonst sind die Werte nicht aussagekräftig.
+ */
+int main( int argc, char** argv ) {
+    if( argc > 1 )
+        filter = argv[1];
+    std::cout << "messung,einheit,ns_pro_einheit,einheiten_pro_s\n";
+    ///
+    ///Benchmark ggT
+    std::mt19937_64 zufall( 17 );
+    std::vector<std::pair<unsigned long int, unsigned long int>> zufallsPaare( 1 << 16 );
+    for( auto& paar : zufallsPaare )
+        paar = { zufall() >> 1, zufall() >> 1 };
+    ///Aufeinanderfolgende Fibonacci-Zahlen sind der schlechteste Fall für den Euklidischen Algorithmus.
+    std::vector<std::pair<unsigned long int, unsigned long int>> fibonacciPaare;
+    unsigned long int f0 = 1, f1 = 1;
+    while( f1 < ( 1UL << 62 ) ) {
+        fibonacciPaare.push_back( { f1, f0 } );
+        unsigned long int f2 = f0 + f1;
+        f0 = f1;
+        f1 = f2;
+    }
+    for( const auto& [name, paare] : { std::make_pair( "zufall", zufallsPaare ), std::make_pair( "fibonacci", fibonacciPaare ) } ) {
+        messe( std::string( "ggt/rekursiv/" ) + name, paare.size(), [&paare]() {
+            for( const auto& [a, b] : paare )
+                senke = senke + ggtRekursiv( a, b );
+        } );
+        messe( std::string( "ggt/binaer/" ) + name, paare.size(), [&paare]() {
+            for( const auto& [a, b] : paare )
+                senke = senke + ggt( a, b );
+        } );
+    }
+    ///
+    ///Benchmark der Bausteine und ganzer Terme je Datentyp
+    messeDatentyp<int>( zufall, "int" );
+    messeDatentyp<long int>( zufall, "long" );
+    messeDatentyp<unsigned long int>( zufall, "ulong" );
+    messeDatentyp<double>( zufall, "double" );
+    ///
+    ///Benchmark Addition bei gleichen bzw. teilbaren Nennern
+    messeGemeinsamenNenner<long int, KuerzeNie>( "long/nie" );
+    messeGemeinsamenNenner<long int, KuerzeImmer>( "long/immer" );
+    messeGemeinsamenNenner<Langzahl, KuerzeNie>( "langzahl/nie" );
+    ///
+    ///Benchmark Langzahl
+    std::vector<std::pair<Langzahl, Langzahl>> kleineLangzahlen, grosseLangzahlen;
+    for( const auto& [a, b] : zufallsPaare ) {
+        kleineLangzahlen.push_back( { a, b } );
+        ///Zwei Zahlen mit 256 Bit und einem gemeinsamen Faktor von 64 Bit
+        if( grosseLangzahlen.size() < 1024 ) {
+            const Langzahl faktor = Langzahl( zufall() ) * Langzahl( zufall() ) * Langzahl( zufall() );
+            const Langzahl gemeinsam( zufall() );
+            grosseLangzahlen.push_back( { faktor * Langzahl( a ) * gemeinsam, faktor * Langzahl( b ) * gemeinsam } );
+        }
+    }
+    for( const auto& [name, paare] : { std::make_pair( "64bit", &kleineLangzahlen ), std::make_pair( "256bit", &grosseLangzahlen ) } ) {
+        messe( std::string( "langzahl/ggt/" ) + name, paare->size(), [paare]() {
+            for( const auto& [a, b] : *paare )
+                senke = senke + bitbreite( ggt( a, b ) );
+        } );
+        messe( std::string( "langzahl/mul/" ) + name, paare->size(), [paare]() {
+            for( const auto& [a, b] : *paare )
+                senke = senke + bitbreite( a * b );
+        } );
+    }
+    ///
+    ///Benchmark Kürzungsstrategien
+    ///Die Terme sind so kurz gewählt, dass auch ohne Kürzen kein long überläuft.
+    for( char rechenzeichen : {'+', '*'} ) {
+        const auto terme = erzeugeTerme( zufall, rechenzeichen, 1 << 10, 8 );
+        const std::string art = rechenzeichen == '+' ? "addition" : "multiplikation";
+        messeKuerzung<KuerzeNie>( "kuerzung/nie/" + art, terme );
+        messeKuerzung<KuerzeImmer>( "kuerzung/immer/" + art, terme );
+        messeKuerzung<KuerzeAbBitbreite<32>>( "kuerzung/ab32bit/" + art, terme );
+        messe( "parser/string_view/vektor/" + art, terme.size(), [&terme]() {
+            for( const auto& term : terme )
+                senke = senke + berechneMitVektor( term ).getNenner();
+        }, "term" );
+        messe( "parser/string_view/" + art, terme.size(), [&terme]() {
+            for( const auto& term : terme )
+                senke = senke + berechneNaechstenTerm<long int>( std::string_view( term ) ).getNenner();
+        }, "term" );
+        messe( "langzahl/" + art, terme.size(), [&terme]() {
+            for( const auto& str : terme ) {
+                std::istringstream term( str );
+                senke = senke + bitbreite( berechneNaechstenTerm<Langzahl>( term ).getNenner() );
+            }
+        }, "term" );
+        messe( "ueberlaufschutz/" + art, terme.size(), [&terme]() {
+            for( const auto& str : terme )
+                senke = senke + std::get<Bruch<long int>>( berechneTermMitUeberlaufschutz( str ) ).getNenner();
+        }, "term" );
+    }
+    ///
+    ///Benchmark Fehlerbehandlung: jeder fünfte Term ist fehlerhaft
+    {
+        auto terme = erzeugeTerme( zufall, '+', 1 << 10, 8 );
+        for( std::size_t i = 0; i < terme.size(); i += 5 )
+            terme[i] += " +";
+        messe( "fehler/exception", terme.size(), [&terme]() {
+            for( const auto& term : terme ) {
+                try {
+                    senke = senke + berechneNaechstenTerm<long int>( std::string_view( term ) ).getNenner();
+                } catch( const std::runtime_error& e ) {
+                    senke = senke + 1;
+                }
+            }
+        }, "term" );
+        messe( "fehler/fehlercode", terme.size(), [&terme]() {
+            for( const auto& term : terme ) {
+                const auto ergebnis = berechneNaechstenTermOhneAusnahme<long int>( term );
+                senke = senke + ( ergebnis ? ergebnis.wert.getNenner() : 1 );
+            }
+        }, "term" );
+    }
+    ///
+    ///Benchmark n-stellige Rechenzeichen: Kette binärer Operationen gegen "N Σ" bzw. "N Π"
+    ///Harmonische Summe 1/1 + ... + 1/18 und das Teleskopprodukt 1/2 * 2/3 * ... * 18/19, beide passen ungekürzt in long.
+    {
+        std::string summeBinaer = "1", summeFusioniert = "1", produktBinaer = "1/2", produktFusioniert = "1/2";
+        for( int k = 2; k <= 18; k++ ) {
+            summeBinaer += " 1/" + std::to_string( k ) + " +";
+            summeFusioniert += " 1/" + std::to_string( k );
+            produktBinaer += " " + std::to_string( k ) + "/" + std::to_string( k + 1 ) + " *";
+            produktFusioniert += " " + std::to_string( k ) + "/" + std::to_string( k + 1 );
+        }
+        summeFusioniert += " 18 Σ";
+        produktFusioniert += " 18 Π";
+        for( const auto& [name, term] : { std::make_pair( "reduktion/summe/binaer", &summeBinaer ), std::make_pair( "reduktion/summe/n-stellig", &summeFusioniert ),
+                                          std::make_pair( "reduktion/produkt/binaer", &produktBinaer ), std::make_pair( "reduktion/produkt/n-stellig", &produktFusioniert ) } )
+            messe( name, 1, [term]() {
+                senke = senke + berechneNaechstenTerm<long int>( std::string_view( *term ) ).getNenner();
+            }, "term" );
+    }
+    ///
+    ///Benchmark Termprogramm: dieselbe Formel für viele Belegungen
+    {
+        static const char formel[] = "x y * x y + / x 1/2 + *";
+        const std::size_t anzahl = 1 << 12;
+        std::vector<Bruch<long int>> belegungen;
+        std::vector<std::string> terme;
+        for( std::size_t i = 0; i < anzahl; i++ ) {
+            const long int x = zufall() % 60 + 1;
+            const long int y = zufall() % 60 + 1;
+            belegungen.push_back( x );
+            belegungen.push_back( y );
+            terme.push_back( std::to_string( x ) + " " + std::to_string( y ) + " * " + std::to_string( x ) + " " + std::to_string( y ) + " + / " + std::to_string( x ) + " 1/2 + *" );
+        }
+        messe( "termprogramm/parsen", anzahl, [&terme]() {
+            for( const auto& term : terme )
+                senke = senke + berechneNaechstenTerm<long int>( std::string_view( term ) ).getNenner();
+        }, "term" );
+        const Termprogramm<long int> programm( formel, { "x", "y" } );
+        std::vector<Bruch<long int>> ergebnisse;
+        messe( "termprogramm/uebersetzt", anzahl, [&]() {
+            ergebnisse.clear();
+            programm.berechneAlle( belegungen.data(), anzahl, ergebnisse );
+            senke = senke + ergebnisse.back().getNenner();
+        }, "term" );
+        std::vector<Bruchspalte<long int>> spalten( 2, Bruchspalte<long int>( anzahl ) );
+        for( std::size_t i = 0; i < anzahl; i++ ) {
+            spalten[0].setze( i, belegungen[2 * i] );
+            spalten[1].setze( i, belegungen[2 * i + 1] );
+        }
+        messe( "termprogramm/spaltenweise", anzahl, [&]() {
+            senke = senke + berechneSpaltenweise( programm, spalten ).getNenner()[anzahl - 1];
+        }, "term" );
+        ///Die Addition allein: spaltenweise gegen zeilenweise mit Bruch (dort inklusive Speicherzugriff auf die Paare aus Zähler und Nenner)
+        Bruchspalte<long int> summe( anzahl );
+        messe( "bruchspalte/addition", anzahl, [&]() {
+            std::copy_n( spalten[0].getZaehler(), anzahl, summe.getZaehler() );
+            std::copy_n( spalten[0].getNenner(), anzahl, summe.getNenner() );
+            addiereSpalte( summe, spalten[1] );
+            senke = senke + summe.getNenner()[anzahl - 1];
+        } );
+        std::vector<Bruch<long int>> summen( anzahl );
+        messe( "bruch/addition", anzahl, [&]() {
+            for( std::size_t i = 0; i < anzahl; i++ )
+                summen[i] = belegungen[2 * i] + belegungen[2 * i + 1];
+            senke = senke + summen.back().getNenner();
+        } );
+    }
+    ///
+    ///Benchmark Termgraph: eine Formel, in der derselbe Teilterm 16-mal vorkommt, mit und ohne gemeinsame Teilterme
+    {
+        std::string formel = "x 1/3 + y * 1/3 1/7 + *";
+        for( int i = 1; i < 16; i++ )
+            formel += i % 2 ? " y x 1/3 + * 1/7 1/3 + * +" : " x 1/3 + y * 1/3 1/7 + * +";
+        const std::size_t anzahl = 1 << 12;
+        std::vector<Bruch<long int, KuerzeImmer>> belegungen;
+        for( std::size_t i = 0; i < 2 * anzahl; i++ )
+            belegungen.push_back( static_cast<long int>( zufall() % 60 + 1 ) );
+        const Termprogramm<long int, KuerzeImmer> programm( formel, { "x", "y" } );
+        const Termgraph<long int, KuerzeImmer> graph( programm );
+        if( std::string( "termgraph/termgraph" ).find( filter ) != std::string::npos )
+            std::cerr << "termgraph: " << graph.getAnweisungenImProgramm() << " Operationen im Termprogramm, " << graph.getKnoten().size() << " im Termgraphen ("
+                      << graph.getGefaltet() << " gefaltet, " << graph.getWiederverwendet() << " wiederverwendet)\n";
+        std::vector<Bruch<long int, KuerzeImmer>> ergebnisse;
+        messe( "termgraph/termprogramm", anzahl, [&]() {
+            ergebnisse.clear();
+            programm.berechneAlle( belegungen.data(), anzahl, ergebnisse );
+            senke = senke + ergebnisse.back().getNenner();
+        }, "term" );
+        messe( "termgraph/termgraph", anzahl, [&]() {
+            ergebnisse.clear();
+            graph.berechneAlle( belegungen.data(), anzahl, ergebnisse );
+            senke = senke + ergebnisse.back().getNenner();
+        }, "term" );
+    }
+    ///
+    ///Benchmark Baumreduktion: viele Brüche mit Langzahl summieren bzw. multiplizieren
+    ///Verglichen werden die Kette binärer Operationen, die n-stelligen Operatoren (summiere, multipliziere) und der balancierte Baum ohne und mit Threads.
+    {
+        const std::size_t anzahl = 1 << 10;
+        std::vector<Bruch<Langzahl>> brueche;
+        for( std::size_t i = 0; i < anzahl; i++ )
+            brueche.emplace_back( Langzahl( 1 + zufall() % 1000000 ), Langzahl( 1 + zufall() % 1000000 ) );
+        messe( "baum/summe/kette", anzahl, [&brueche]() {
+            Bruch<Langzahl> summe( 0 );
+            for( const auto& b : brueche )
+                summe = kuerzeBruch( summe + b );
+            senke = senke + bitbreite( summe.getNenner() );
+        } );
+        messe( "baum/summe/n-stellig", anzahl, [&brueche]() {
+            senke = senke + bitbreite( summiere( brueche.data(), brueche.size() ).getNenner() );
+        } );
+        messe( "baum/produkt/n-stellig", anzahl, [&brueche]() {
+            senke = senke + bitbreite( multipliziere( brueche.data(), brueche.size() ).getNenner() );
+        } );
+        const unsigned kerne = std::max( 1u, std::thread::hardware_concurrency() );
+        for( unsigned threads = 1; threads <= kerne; threads *= 2 ) {
+            ///Ohne Threads wird der Baum direkt berechnet, sonst auf einem Arbeitspool, der für alle Wiederholungen bestehen bleibt.
+            std::unique_ptr<Arbeitspool> pool( threads > 1 ? new Arbeitspool( threads ) : nullptr );
+            messe( "baum/summe/threads" + std::to_string( threads ), anzahl, [&brueche, &pool]() {
+                senke = senke + bitbreite( ( pool ? summiereBaum( brueche.data(), brueche.size(), *pool ) : summiereBaum( brueche.data(), brueche.size(), 1 ) ).getNenner() );
+            } );
+            messe( "baum/produkt/threads" + std::to_string( threads ), anzahl, [&brueche, &pool]() {
+                senke = senke + bitbreite( ( pool ? multipliziereBaum( brueche.data(), brueche.size(), *pool ) : multipliziereBaum( brueche.data(), brueche.size(), 1 ) ).getNenner() );
+            } );
+        }
+    }
+    ///
+    ///Benchmark Modularrechner: tiefe Terme exakt mit Langzahl gegen die Berechnung modulo vieler Primzahlen
+    ///Die Kette der harmonischen Summe lässt die ungekürzten Brüche stark wachsen, das gekürzte Ergebnis bleibt deutlich kleiner.
+    ///Das Produkt (1 + 1/k) aller k wird erst am Ende auf n + 1 gekürzt.
+    for( int laenge : { 250, 1000 } ) {
+        std::string summe = "1", produkt = "2";
+        for( int k = 2; k <= laenge; k++ ) {
+            summe += " 1/" + std::to_string( k ) + " +";
+            produkt += " 1 1/" + std::to_string( k ) + " + *";
+        }
+        for( const auto& [name, term] : { std::make_pair( "summe", &summe ), std::make_pair( "produkt", &produkt ) } ) {
+            const std::string kennung = std::string( "modular/" ) + name + std::to_string( laenge );
+            messe( kennung + "/exakt", 1, [term]() {
+                senke = senke + bitbreite( berechneNaechstenTerm<Langzahl>( std::string_view( *term ) ).getNenner() );
+            }, "term" );
+            messe( kennung + "/crt", 1, [term]() {
+                senke = senke + bitbreite( berechneTermModular( *term, 1 ).getNenner() );
+            }, "term" );
+        }
+    }
+    ///
+    ///Benchmark Termstrom: ein langer Term am Stück gegen dieselben Zeichen in Blöcken von 64 KiB
+    {
+        std::string term = "1/3";
+        for( int i = 0; i < 200000; i++ )
+            term += i % 2 ? " 1/3 +" : " 1/-3 +";
+        const std::size_t zahlen = 200001;
+        messe( "strom/am_stueck", zahlen, [&term]() {
+            senke = senke + berechneNaechstenTermOhneAusnahme<long int, KuerzeImmer>( term ).wert.getNenner();
+        }, "zahl" );
+        messe( "strom/bloecke", zahlen, [&term]() {
+            Termstrom<long int, KuerzeImmer> strom;
+            auto merke = []( const Termergebnis<Bruch<long int, KuerzeImmer>>& ergebnis ) {
+                senke = senke + ergebnis.wert.getNenner();
+            };
+            for( std::size_t i = 0; i < term.size(); i += 1 << 16 )
+                strom.lies( std::string_view( term ).substr( i, 1 << 16 ), merke );
+            strom.beende( merke );
+        }, "zahl" );
+    }
+    ///
+    ///Benchmark Infix: dieselben Terme in Postfix- und in Infixnotation mit so wenigen Klammern wie nötig
+    {
+        std::mt19937_64 zufallInfix( 7 );
+        for( const Termgenerator& generator : { Termgenerator{ "flach", 2, { 1, 1, 1, 1 }, 0.0, 9 }, Termgenerator{ "tief", 5, { 1, 1, 1, 1 }, 0.0, 9 } } ) {
+            std::vector<std::string> postfix, infix;
+            while( postfix.size() < ( 1 << 10 ) ) {
+                std::string term = generator.erzeuge( zufallInfix );
+                if( !istBerechenbar<long int>( term ) )
+                    continue;
+                infix.push_back( zuInfix( term ) );
+                postfix.push_back( std::move( term ) );
+            }
+            Termrechner<long int> rechner;
+            messe( "infix/" + generator.name + "/postfix", postfix.size(), [&]() {
+                for( const auto& term : postfix )
+                    senke = senke + rechner.berechneOhneAusnahme( term ).wert.getNenner();
+            }, "term" );
+            messe( "infix/" + generator.name + "/infix", infix.size(), [&]() {
+                for( const auto& term : infix )
+                    senke = senke + rechner.berechneInfixOhneAusnahme( term ).wert.getNenner();
+            }, "term" );
+        }
+    }
+    ///
+    ///Benchmark Sortierung: 2^20 Brüche mit kleinen bzw. fast 64 Bit breiten Zählern und Nennern
+    {
+        std::mt19937_64 zufallSortierung( 31 );
+        const std::size_t anzahl = 1 << 20;
+        std::vector<Bruch<long int>> klein, breit;
+        for( std::size_t i = 0; i < anzahl; i++ ) {
+            klein.emplace_back( static_cast<long int>( zufallSortierung() % 1000 ) + 1, static_cast<long int>( zufallSortierung() % 2000001 ) - 1000000 );
+            breit.emplace_back( static_cast<long int>( zufallSortierung() >> 2 ) + 1, static_cast<long int>( zufallSortierung() >> 1 ) - ( 1l << 62 ) );
+        }
+        for( const auto& [name, brueche] : { std::make_pair( "klein", &klein ), std::make_pair( "breit", &breit ) } ) {
+            std::vector<Bruch<long int>> kopie;
+            messe( std::string( "sortierung/" ) + name + "/std_sort", anzahl, [&, brueche = brueche]() {
+                kopie = *brueche;
+                std::sort( kopie.begin(), kopie.end(), []( const Bruch<long int>& a, const Bruch<long int>& b ) {
+                    return a < b;
+                } );
+                senke = senke + kopie.front().getNenner();
+            } );
+            messe( std::string( "sortierung/" ) + name + "/sortiereBrueche", anzahl, [&, brueche = brueche]() {
+                kopie = *brueche;
+                sortiereBrueche( kopie );
+                senke = senke + kopie.front().getNenner();
+            } );
+        }
+    }
+    ///
+    ///Benchmark Ausgabe
+    std::vector<Bruch<long int>> brueche;
+    for( int i = 0; i < 1 << 12; i++ )
+        brueche.emplace_back( static_cast<long int>( zufall() >> 34 ) + 1, static_cast<long int>( zufall() >> 2 ) - ( 1l << 61 ) );
+    messe( "ausgabe/ostream", brueche.size(), [&brueche]() {
+        std::ostringstream os;
+        for( const auto& b : brueche )
+            os << b << "\n";
+        senke = senke + os.str().size();
+    } );
+    std::string text;
+    messe( "ausgabe/to_chars", brueche.size(), [&brueche, &text]() {
+        text.clear();
+        for( const auto& b : brueche ) {
+            haengeBruchAn( text, b );
+            text += '\n';
+        }
+        senke = senke + text.size();
+    } );
+    ///
+    ///Benchmark Stapelverarbeitung
+    static const char dateiname[] = "BruchrechnerBenchmark_Stapel.txt";
+    std::size_t zeilen = 0;
+    {
+        std::ofstream datei( dateiname );
+        for( char rechenzeichen : {'+', '*'} )
+            for( const auto& term : erzeugeTerme( zufall, rechenzeichen, 1 << 15, 8 ) ) {
+                datei << term << "\n";
+                zeilen++;
+            }
+    }
+    ///Die Ausgaben werden nach /dev/null geschrieben, gemessen wird also auch die Formatierung und das Schreiben.
+    const int nichts = open( "/dev/null", O_WRONLY );
+    Ausgabepuffer verwerfen( nichts );
+    const unsigned kerne = std::max( 1u, std::thread::hardware_concurrency() );
+    for( unsigned threads = 1; threads <= kerne; threads *= 2 )
+        messe( "stapel/threads" + std::to_string( threads ), zeilen, [&verwerfen, threads]() {
+            berechneDatei( dateiname, verwerfen, threads, false );
+        }, "term" );
+    std::remove( dateiname );
+    ///
+    ///Benchmark Ergebniscache: 1 << 15 Zeilen aus nur 256 verschiedenen, teils mit anderem Leerraum geschriebenen Termen
+    {
+        std::ofstream datei( dateiname );
+        const auto terme = erzeugeTerme( zufall, '+', 256, 16 );
+        for( int i = 0; i < 1 << 15; i++ )
+            datei << ( i % 3 == 0 ? " " : "" ) << terme[zufall() % terme.size()] << "\n";
+    }
+    for( const bool geprueft : { false, true } ) {
+        const std::string art = geprueft ? "geprueft" : "long";
+        messe( "cache/" + art + "/ohne", 1 << 15, [&verwerfen, geprueft]() {
+            berechneDatei( dateiname, verwerfen, 1, geprueft );
+        }, "term" );
+        messe( "cache/" + art + "/mit", 1 << 15, [&verwerfen, geprueft]() {
+            Ergebniscache cache( 1 << 20 );
+            berechneDatei( dateiname, verwerfen, 1, geprueft, false, &cache );
+        }, "term" );
+    }
+    std::remove( dateiname );
+    close( nichts );
+}
+
+/**
+    @brief Erzeugt zufällige Terme mit nur einem Rechenzeichen.
+    Die Brüche haben Zähler und Nenner zwischen 1 und 60.
+    @param zufall: Zufallsgenerator
+    @param rechenzeichen: Das Rechenzeichen aller Operationen
+    @param anzahl: Anzahl der Terme
+    @param laenge: Anzahl der Brüche pro Term
+    @returns Die Terme in Postfixnotation
+ */
+std::vector<std::string> erzeugeTerme( std::mt19937_64& zufall, char rechenzeichen, std::size_t anzahl, std::size_t laenge ) {
+    std::vector<std::string> terme( anzahl );
+    for( auto& term : terme ) {
+        std::ostringstream os;
+        for( std::size_t i = 0; i < laenge; i++ ) {
+            os << 1 + zufall() % 60 << "/" << 1 + zufall() % 60 << " ";
+            if( i > 0 )
+                os << rechenzeichen << " ";
+        }
+        term = os.str();
+    }
+    return terme;
+}
+
+/**
+    @brief Misst ggT, Kürzen, die Rechenoperatoren, das Einlesen und ganze Terme für den Datentyp T.
+    Die Zahlen sind so klein gewählt, dass eine einzelne Operation ohne Kürzen nicht überläuft. Für ganze Terme werden nur Terme gemessen, die in T ohne Überlauf
+    und ohne Division durch Null berechnet werden können. Findet der Termgenerator dafür nicht genug Terme, wird die Messung übersprungen und auf std::cerr gemeldet.
+    @arg T: Datentyp von Zähler und Nenner
+    @param zufall: Zufallsgenerator
+    @param typ: Name des Datentyps für die Namen der Messungen
+ */
+template <typename T> void messeDatentyp( std::mt19937_64& zufall, const std::string& typ ) {
+    constexpr int bits = std::numeric_limits<T>::digits;
+    const std::size_t anzahl = 1 << 12;
+    ///Bausteine
+    const auto a = erzeugeBrueche<T>( zufall, anzahl, bits / 2 - 1 );
+    const auto b = erzeugeBrueche<T>( zufall, anzahl, bits / 2 - 1 );
+    if constexpr( std::is_integral<T>::value )
+        messe( "ggt/" + typ, anzahl, [&a]() {
+            for( const auto& x : a )
+                senke = senke + ggt( x.getZaehler(), x.getNenner() );
+        } );
+    ///Zähler und Nenner mit einem gemeinsamen Faktor
+    std::vector<Bruch<T>> ungekuerzt;
+    const auto faktoren = erzeugeBrueche<T>( zufall, anzahl, bits / 3 );
+    for( const auto& x : erzeugeBrueche<T>( zufall, anzahl, bits / 3 ) )
+        ungekuerzt.emplace_back( x.getNenner() * faktoren[ungekuerzt.size()].getNenner(), x.getZaehler() * faktoren[ungekuerzt.size()].getNenner() );
+    std::vector<Bruch<T>> ergebnisse( anzahl );
+    messe( "kuerzeBruch/" + typ, anzahl, [&]() {
+        for( std::size_t i = 0; i < anzahl; i++ ) {
+            ergebnisse[i] = ungekuerzt[i];
+            ergebnisse[i].kuerzeBruch();
+        }
+        senke = senke + static_cast<unsigned long int>( ergebnisse.back().getNenner() );
+    } );
+    const std::pair<const char*, Bruch<T> ( * )( const Bruch<T>&, const Bruch<T>& )> operatoren[] = {
+        { "addition", add<Bruch<T>> }, { "subtraktion", sub<Bruch<T>> }, { "multiplikation", mul<Bruch<T>> }, { "division", div<Bruch<T>> }
+    };
+    for( const auto& [name, operation] : operatoren )
+        messe( std::string( "operator/" ) + name + "/" + typ, anzahl, [&, operation = operation]() {
+            for( std::size_t i = 0; i < anzahl; i++ )
+                ergebnisse[i] = operation( a[i], b[i] );
+            senke = senke + static_cast<unsigned long int>( ergebnisse.back().getNenner() );
+        } );
+    std::ostringstream text;
+    for( const auto& x : a )
+        text << x.getZaehler() << "/" << x.getNenner() << " ";
+    const std::string eingabe = text.str();
+    messe( "parser/istream/" + typ, anzahl, [&]() {
+        std::istringstream is( eingabe );
+        for( std::size_t i = 0; i < anzahl; i++ )
+            is >> ergebnisse[i];
+        senke = senke + static_cast<unsigned long int>( ergebnisse.back().getNenner() );
+    } );
+    ///Ganze Terme
+    static const Termgenerator generatoren[] = {
+        { "flach/gemischt/klein", 2, { 1, 1, 1, 1 }, 0.0, 9 },
+        { "flach/additiv/gross", 2, { 1, 1, 0, 0 }, 0.0, 1000 },
+        { "flach/multiplikativ/gross", 2, { 0, 0, 1, 1 }, 0.0, 1000 },
+        { "tief/gemischt/klein", 5, { 1, 1, 1, 1 }, 0.5, 9 }
+    };
+    for( const auto& generator : generatoren ) {
+        std::vector<std::string> terme;
+        for( std::size_t versuch = 0; terme.size() < ( 1 << 10 ) && versuch < ( 1 << 16 ); versuch++ ) {
+            std::string term = generator.erzeuge( zufall );
+            if( istBerechenbar<T>( term ) )
+                terme.push_back( std::move( term ) );
+        }
+        const std::string name = typ + "/" + generator.name;
+        if( terme.size() < ( 1 << 10 ) ) {
+            if( ( "term/istream/" + name ).find( filter ) != std::string::npos || ( "term/string_view/" + name ).find( filter ) != std::string::npos )
+                std::cerr << "term/*/" << name << " übersprungen: zu wenige Terme ohne Überlauf\n";
+            continue;
+        }
+        messe( "term/istream/" + name, terme.size(), [&terme]() {
+            for( const auto& str : terme ) {
+                std::istringstream term( str );
+                senke = senke + static_cast<unsigned long int>( berechneNaechstenTerm<T>( term ).getNenner() );
+            }
+        }, "term" );
+        messe( "term/string_view/" + name, terme.size(), [&terme]() {
+            for( const auto& term : terme )
+                senke = senke + static_cast<unsigned long int>( berechneNaechstenTerm<T>( std::string_view( term ) ).getNenner() );
+        }, "term" );
+    }
+}
+
+/**
+    @brief Schreibt einen Postfixterm ohne "k" in Infixnotation um.
+    Ein Teilterm wird nur geklammert, wenn sein Rechenzeichen schwächer bindet als das umgebende oder er rechts von "-" bzw. "/" mit gleichem Rang steht.
+ */
+std::string zuInfix( std::string_view postfix ) {
+    ///Teilterm und Rang seines äußersten Rechenzeichens, 3 für eine Zahl
+    std::vector<std::pair<std::string, int>> stapel;
+    Termzerleger zerleger( postfix );
+    while( zerleger.ueberspringeLeerzeichen() ) {
+        const std::size_t anfang = zerleger.getPosition();
+        if( zerleger.naechsteIstZahl() ) {
+            Bruch<long int> b;
+            zerleger.leseBruchOhneAusnahme( b );
+            stapel.emplace_back( std::string( postfix.substr( anfang, zerleger.getPosition() - anfang ) ), 3 );
+            continue;
+        }
+        const char c = zerleger.leseZeichen();
+        const int rang = c == '+' || c == '-' ? 1 : 2;
+        auto rechts = std::move( stapel.back() );
+        stapel.pop_back();
+        auto& links = stapel.back();
+        if( links.second < rang )
+            links.first = "(" + links.first + ")";
+        if( rechts.second < rang || ( rechts.second == rang && ( c == '-' || c == '/' ) ) )
+            rechts.first = "(" + rechts.first + ")";
+        links.first += std::string( " " ) + c + " " + rechts.first;
+        links.second = rang;
+    }
+    return stapel.back().first;
+}
+
+/**
+    @brief Erzeugt zufällige positive Brüche, deren Zähler und Nenner höchstens bits Bit haben.
+ */
+template <typename T> std::vector<Bruch<T>> erzeugeBrueche( std::mt19937_64& zufall, std::size_t anzahl, int bits ) {
+    std::vector<Bruch<T>> brueche;
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        const T zaehler = static_cast<T>( 1 + ( zufall() >> ( 64 - bits ) ) );
+        brueche.emplace_back( static_cast<T>( 1 + ( zufall() >> ( 64 - bits ) ) ), zaehler );
+    }
+    return brueche;
+}
+
+/**
+    @brief Misst Addition und Subtraktion von Brüchen mit festen Nennern, wie sie bei Geldbeträgen (Cent) oder Zweier- und Zehnerpotenzen vorkommen.
+    Zum Vergleich wird mit zufälligen, meist teilerfremden Nennern gerechnet. Die Kette summiert alle Beträge nacheinander, mit long int nur, wenn gekürzt wird, da der Nenner sonst überläuft.
+    @arg T: Datentyp von Zähler und Nenner
+    @arg Kuerzung: Kürzungsstrategie der Brüche
+    @param typ: Name von Datentyp und Kürzungsstrategie für die Namen der Messungen
+ */
+template <typename T, typename Kuerzung> void messeGemeinsamenNenner( const std::string& typ ) {
+    using B = Bruch<T, Kuerzung>;
+    std::mt19937_64 zufallNenner( 23 );
+    const std::size_t anzahl = 1 << 12;
+    std::vector<std::pair<B, B>> gleich, teiler, zweierpotenzen, zufaellig;
+    for( std::size_t i = 0; i < anzahl; i++ ) {
+        gleich.push_back( { B( T( 100 ), T( zufallNenner() % 10000 ) ), B( T( 100 ), T( zufallNenner() % 10000 ) ) } );
+        const B tausendstel( T( 1000 ), T( zufallNenner() % 100000 ) ), zehntel( T( 10 ), T( zufallNenner() % 1000 ) );
+        teiler.push_back( i % 2 ? std::make_pair( tausendstel, zehntel ) : std::make_pair( zehntel, tausendstel ) );
+        zweierpotenzen.push_back( { B( T( 1l << ( zufallNenner() % 20 ) ), T( zufallNenner() % 100000 ) ), B( T( 1l << ( zufallNenner() % 20 ) ), T( zufallNenner() % 100000 ) ) } );
+        zufaellig.push_back( { B( T( 1 + zufallNenner() % ( 1 << 20 ) ), T( zufallNenner() % 100000 ) ), B( T( 1 + zufallNenner() % ( 1 << 20 ) ), T( zufallNenner() % 100000 ) ) } );
+    }
+    std::vector<B> ergebnisse( anzahl );
+    for( const auto& [name, paare] : { std::make_pair( "gleich", &gleich ), std::make_pair( "teiler", &teiler ), std::make_pair( "zweierpotenzen", &zweierpotenzen ), std::make_pair( "zufaellig", &zufaellig ) } ) {
+        messe( "nenner/" + typ + "/addition/" + name, anzahl, [&, paare = paare]() {
+            for( std::size_t i = 0; i < anzahl; i++ )
+                ergebnisse[i] = ( *paare )[i].first + ( *paare )[i].second;
+            senke = senke + bitbreite( ergebnisse.back().getNenner() );
+        } );
+        messe( "nenner/" + typ + "/subtraktion/" + name, anzahl, [&, paare = paare]() {
+            for( std::size_t i = 0; i < anzahl; i++ )
+                ergebnisse[i] = ( *paare )[i].first - ( *paare )[i].second;
+            senke = senke + bitbreite( ergebnisse.back().getNenner() );
+        } );
+    }
+    if constexpr( std::is_same<Kuerzung, KuerzeImmer>::value || !IstEingebauteGanzzahl<T>::value )
+        for( const auto& [name, paare] : { std::make_pair( "gleich", &gleich ), std::make_pair( "zweierpotenzen", &zweierpotenzen ) } )
+            messe( "nenner/" + typ + "/kette/" + name, anzahl, [&, paare = paare]() {
+                B summe( 0 );
+                for( const auto& paar : *paare )
+                    summe = summe + paar.first;
+                senke = senke + bitbreite( summe.getNenner() );
+            } );
+}
+
+/**
+    @brief Prüft, ob term im Datentyp T ohne Überlauf und ohne Division durch Null berechnet werden kann.
+    Ganzzahlige Typen werden dazu mit Geprueft<T> berechnet, das dieselben Rechenschritte überlaufgeprüft ausführt.
+ */
+template <typename T> bool istBerechenbar( const std::string& term ) {
+    if constexpr( std::is_floating_point<T>::value )
+        return static_cast<bool>( berechneNaechstenTermOhneAusnahme<T>( term ) );
+    else
+        return static_cast<bool>( berechneNaechstenTermOhneAusnahme<Geprueft<T>>( term ) );
+}
+
+/**
+    @brief Misst berechneNaechstenTerm mit der Kürzungsstrategie Kuerzung.
+    @arg Kuerzung: Kürzungsstrategie
+    @param name: Name der Messung
+    @param terme: Die zu berechnenden Terme
+ */
+template <typename Kuerzung> void messeKuerzung( const std::string& name, const std::vector<std::string>& terme ) {
+    messe( name, terme.size(), [&terme]() {
+        for( const auto& str : terme ) {
+            std::istringstream term( str );
+            senke = senke + berechneNaechstenTerm<long int, Kuerzung>( term ).getNenner();
+        }
+    }, "term" );
+}
+
+/**
+    @brief Bisheriger rekursiver ggT als Vergleichswert.
+    Der Algorithmus ist dem GdP Seminar Aufgabe 5.4 entnommen.
+ */
+unsigned long int ggtRekursiv( const unsigned long int& a, const unsigned long int& b ) {
+    if( a < b )
+        return ggtRekursiv( b, a );
+    else if( ( a % b ) == 0 )
+        return b;
+    else
+        return ggtRekursiv( b, a % b );
+}
+
+/**
+    @brief Bisherige Berechnung mit einem neuen std::vector je Term und berechneOperation als Vergleichswert.
+ */
+Bruch<long int> berechneMitVektor( std::string_view term ) {
+    std::vector<Bruch<long int>> zahlenstapel;
+    Termzerleger zerleger( term );
+    while( zerleger.ueberspringeLeerzeichen() ) {
+        if( zerleger.naechsteIstZahl() ) {
+            zahlenstapel.push_back( zerleger.leseBruch<long int, KuerzeNie>() );
+            continue;
+        }
+        switch( zerleger.leseZeichen() ) {
+            case '+':
+                berechneOperation( zahlenstapel, add<Bruch<long int>> );
+                break;
+            case '*':
+                berechneOperation( zahlenstapel, mul<Bruch<long int>> );
+                break;
+            default:
+                throw std::runtime_error( "Im Benchmark werden nur + und * genutzt." );
+        }
+    }
+    Bruch<long int> b = zahlenstapel.front();
+    b.kuerzeBruch();
+    return b;
+}
+
+/**
+    @brief Misst die Laufzeit von durchlauf und gibt sie pro Operation als CSV-Zeile aus.
+    Der Durchlauf wird so oft wiederholt, bis mindestens 200ms vergangen sind. Passt der Name nicht zum Filter, wird nichts gemessen.
+    @arg F: Typ der Messfunktion
+    @param name: Name der Messung
+    @param operationen: Anzahl der Operationen pro Durchlauf
+    @param durchlauf: Die zu messende Funktion
+    @param einheit: Was eine Operation ist, "op" oder "term"
+ */
+template <typename F> void messe( const std::string& name, std::size_t operationen, F durchlauf, const char* einheit ) {
+    using Uhr = std::chrono::steady_clock;
+    if( name.find( filter ) == std::string::npos )
+        return;
+    durchlauf();
+    std::size_t wiederholungen = 0;
+    const auto start = Uhr::now();
+    auto ende = start;
+    do {
+        durchlauf();
+        wiederholungen++;
+        ende = Uhr::now();
+    } while( ende - start < std::chrono::milliseconds( 200 ) );
+    const double nanosekunden = std::chrono::duration<double, std::nano>( ende - start ).count() / ( wiederholungen * operationen );
+    std::cout << name << "," << einheit << "," << nanosekunden << "," << 1e9 / nanosekunden << std::endl;
+}
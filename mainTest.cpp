@@ -6,12 +6,41 @@
 #include <sstream>
 #include <string>
 #include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <unordered_set>
+#include <limits>
+#include <algorithm>
+
+#include <unistd.h>
 
 #include "Bruchberechner.h"
+#include "Stapelverarbeitung.h"
+#include "Ausgabe.h"
+#include "Termprogramm.h"
+#include "Termgraph.h"
+#include "Bruchsortierung.h"
+#include "Bruchspalte.h"
+#include "Baumreduktion.h"
+#include "Modularrechner.h"
+#include "Termstrom.h"
+#include "Ergebniscache.h"
+#include "Instrumentierung.h"
 
 ///Prototypes
 int summeUeber( const int&, const int&, const int& );
 int siebzehn();
+
+///Eigene Rechenzeichen für Termrechner und Termstrom (siehe Test des Termrechners)
+struct EigeneOperatoren {
+    static constexpr auto tabelle = bruchoperatoren<Bruch<long int>>()
+        .erweitere( definiereOperator( "siebzehn", []() -> Bruch<long int> {
+                return siebzehn();
+            } ) )
+        .erweitere( definiereOperator( "mittel", []( const Bruch<long int>& a, const Bruch<long int>& b ) -> Bruch<long int> {
+                return ( a + b ) / Bruch<long int>( 2 );
+            } ) );
+};
 template <typename T> void operator << ( std::ostream&, std::vector<T> );
 
 /**
@@ -40,6 +69,12 @@ int main() {
             }
         }
         ///
+        std::cout << "ggt( 1071, 462 ) = " << ggt( 1071, 462 ) << "\n";                         ///Der ggT ist ein Template und funktioniert ohne Einschränkung auf unsigned long für alle Ganzzahltypen,
+        std::cout << "ggt( 3 * 2^100, 2^90 ) / 2^80 = "                                            ///auch für 128-Bit-Zahlen.
+                  << static_cast<long int>( ggt( static_cast<__int128>( 3 ) << 100, static_cast<__int128>( 1 ) << 90 ) >> 80 ) << "\n";
+        std::cout << "37/100 + 45/100 - 2/100 = "                                                  ///Bei gleichen Nennern werden nur die Zähler addiert,
+                  << Bruch<long int>( 100, 37 ) + Bruch<long int>( 100, 45 ) - Bruch<long int>( 100, 2 ) << "\n";  ///der Nenner bleibt auch ungekürzt 100.
+        ///
         static const std::string str1 = "0.5/1 0.5/2 +";                            ///Aufgrund der allgemeinen beschreibung der Klasse Bruch können auch andere Zahlentypen als Speicher für Zähler und Nenner dienen
         std::cout << str1 << " = ";                                                 //Denkbar wäre auch die Implementierung von Zähler und Nenner als unterschiedliche Datentypen.
         std::istringstream term1( str1 );                                           //Dies erscheint mir in diesem Fall aber nicht als Sinnvoll.
@@ -49,6 +84,10 @@ int main() {
         std::cout << str2 << " = ";
         std::istringstream term2( str2 );
         std::cout << berechneNaechstenTerm<long unsigned int>( term2 ) << "\n";     ///Dieser Bruchberechner erlaubt bspw. nur natüliche Zahlen als Zähler und Nenner
+        static const std::string str2b = "0 2 - 1/2 * 1 + k";
+        std::cout << str2b << " = ";
+        std::istringstream term2b( str2b );
+        std::cout << berechneNaechstenTerm<long unsigned int>( term2b ) << "\n";    ///Ohne Vorzeichen wird nicht über Kreuz gekürzt, -2 * 1/2 + 1 ergibt auch modulo 2^64 0.
         ///
         static const std::string str3 = "5.7/2";
         std::cout << str3 << " = ";
@@ -60,11 +99,39 @@ int main() {
             std::cout << "\"" << e.what() << "\"\n" << std::endl;
         }
         ///
+        ///Test Vergleiche
+        std::cout << "\n\nTest der Vergleiche:\n";
+        std::cout << std::boolalpha;
+        std::cout << "1/2 == 2/4: " << ( Bruch<int>( 2, 1 ) == Bruch<int>( 4, 2 ) ) << ", -1/-2 == 1/2: " << ( Bruch<int>( -2, -1 ) == Bruch<int>( 2, 1 ) )   ///Verglichen werden Werte, nicht die Darstellung.
+                  << ", -1/2 < 1/-3: " << ( Bruch<int>( 2, -1 ) < Bruch<int>( -3, 1 ) ) << "\n";
+        const long int groesste = std::numeric_limits<long int>::max();
+        std::cout << "(2^63 - 3)/(2^63 - 2) < (2^63 - 2)/(2^63 - 1): "                          ///Die Produkte über Kreuz werden in 128 Bit gebildet.
+                  << ( Bruch<long int>( groesste - 1, groesste - 2 ) < Bruch<long int>( groesste, groesste - 1 ) ) << "\n";
+        const __int128 gross = static_cast<__int128>( 1 ) << 120;
+        std::cout << "(2^120 + 1)/2^120 > (2^120 + 2)/(2^120 + 1): " << ( Bruch<__int128>( gross, gross + 1 ) > Bruch<__int128>( gross + 1, gross + 2 ) ) << "\n";  ///__int128 wird ohne Multiplikation verglichen.
+        std::cout << "2^128/3 > 2^128/4 (Langzahl): " << ( Bruch<Langzahl>( 3, Langzahl( gross ) * 256 ) > Bruch<Langzahl>( 4, Langzahl( gross ) * 256 ) ) << "\n";
+        std::cout << "3/4000000000000000000 < 7/4000000000000000001 (Geprueft): "                 ///Auch geprüfte Brüche werden ohne Überlauf verglichen.
+                  << ( Bruch<Geprueft<long int>>( 4000000000000000000L, 3 ) < Bruch<Geprueft<long int>>( 4000000000000000001L, 7 ) ) << "\n";
+        const std::unordered_set<Bruch<long int>> verschiedene = { Bruch<long int>( 2, 1 ), Bruch<long int>( 4, 2 ), Bruch<long int>( -6, -3 ), Bruch<long int>( 3, 1 ) };
+        std::cout << "Verschiedene Werte in {1/2, 2/4, -3/-6, 1/3}: " << verschiedene.size() << "\n";                   ///Gehasht wird die gekürzte Form.
+        std::vector<Bruch<long int>> brueche;
+        std::uint64_t zufallszahl = 1;
+        for( int i = 0; i < 1000; i++ ) {
+            zufallszahl = zufallszahl * 6364136223846793005ull + 1442695040888963407ull;
+            brueche.emplace_back( static_cast<long int>( zufallszahl >> 54 ) + 1, static_cast<long int>( zufallszahl >> 40 & 0x3ff ) - 512 );
+        }
+        brueche.emplace_back( groesste, groesste - 1 );                                           ///Zwei Werte mit demselben Schlüssel
+        brueche.emplace_back( groesste - 1, groesste - 2 );
+        sortiereBrueche( brueche );
+        std::cout << "Sortiert: " << std::is_sorted( brueche.begin(), brueche.end() ) << ", kleinster Wert: " << brueche.front() << ", größte Werte: "
+                  << brueche[brueche.size() - 3] << ", " << brueche[brueche.size() - 2] << ", " << brueche.back() << "\n";
+        std::cout << std::noboolalpha;
+        ///
         ///Test Berechner
         std::cout << "\n\nTest des Moduls Berechner: \n";
         static const int zahlen[] = {17, 19, -5};
         std::vector<int> zahlenstapel( zahlen, zahlen + sizeof( zahlen ) / sizeof( zahlen[0] ) );   //Quelle: User Yacoby von stackoverflow.com - https://stackoverflow.com/a/2236227
-        std::cout << "Beispielaufgabe: (Summe von k = 17 bis 19 über -5 * k) + Siebzehn. \n";       ///Möglicher Eingabeweg (nicht implementiert!): 17 19 -5 sum siebzehn +
+        std::cout << "Beispielaufgabe: (Summe von k = 17 bis 19 über -5 * k) + Siebzehn. \n";       ///Eingabeweg im Bruchberechner: 17 19 -5 sum siebzehn + (siehe Test der Operatortabelle)
         std::cout << "Rechenschritte: \n";
         std::cout << "zahlenstapel vor der Berechnung: \n" << zahlenstapel;
         berechneOperation( zahlenstapel, summeUeber );                                              ///Das Modul ermöglicht die unkomplizierte Einführung neuer Operatoren mit beliebig vielen Parametern.
@@ -86,11 +153,17 @@ int main() {
             "-1 7 *",                       ///Negative Zahlen können genutzt werden.
             "1/-1 7 *",                     ///Das Minus negativer Zahlen kann auch im Nenner stehen.
             "9/5 1/5 +",                    ///Eine Zahl mit 1 im Nenner wird als Ganzzahl ohne Nenner ausgegeben.
+            "100000/3 300000/100000 *",     ///Beim Multiplizieren wird über Kreuz gekürzt, sodass 100000 * 300000 nicht überläuft.
+            "100000/3 100000/300000 /",     ///Ebenso beim Dividieren.
+            "1 1/2 1/3 1/4 1/5 5 Σ",        ///Die n-stellige Summe nimmt die Anzahl und so viele Zahlen vom Stapel.
+            "1/2 2/3 3/4 4/5 4 prod",       ///Ebenso das n-stellige Produkt, "sum" und "prod" sind andere Namen für Σ und Π.
             "A",                            ///Fehler: Unbekanntes Zeichen
             "1 1",                          ///Fehler: zu wenig Operatoren (bzw. zu viele Zahlen)
             "1 + +",                        ///Fehler: zu viele Operatoren (bzw. zu wenig Zahlen)
             "1/",                           ///Fehler: Nenner wird erwartet
             "1/1 0/1 /",                    ///Fehler: Division durch 0
+            "1 2 1/2 Σ",                    ///Fehler: Die Anzahl ist keine ganze Zahl
+            "1 2 3 Π",                      ///Fehler: Unter der Anzahl liegen zu wenig Zahlen
         };
         for( auto str : termeBruchberechner ) {
             try {
@@ -103,6 +176,412 @@ int main() {
                 std::cout << "\"" << e.what() << "\"\n" << std::endl;
             }
         }
+        ///
+        ///Test Operatortabelle
+        std::cout << "\n\nTest der Operatortabelle:\n";
+        static constexpr auto tabelle = bruchoperatoren<Bruch<int>>()                               ///Die Rechenzeichen des Bruchberechners lassen sich um eigene erweitern (hier ersetzt sum das eingebaute),
+            .erweitere( definiereOperator( "sum", []( const Bruch<int>& a, const Bruch<int>& b, const Bruch<int>& c ) -> Bruch<int> {
+                    return summeUeber( a.getZaehler(), b.getZaehler(), c.getZaehler() );           ///auch mit mehreren Zeichen und beliebig vielen Parametern.
+                } ) )
+            .erweitere( definiereOperator( "siebzehn", []() -> Bruch<int> {
+                    return siebzehn();
+                } ) );
+        static const std::string termeOperatortabelle[] = {
+            "17 19 -5 sum siebzehn +",      ///Das Beispiel aus dem Test des Moduls Berechner
+            "1 2 3 ++",                     ///Rechenzeichen ohne Leerzeichen dazwischen werden einzeln gelesen.
+            "2/4 1/4 +k",
+            "17 19 -5 summe",               ///Fehler: Es wird das längste passende Rechenzeichen gewählt, danach ist "m" unbekannt.
+        };
+        for( auto str : termeOperatortabelle ) {
+            try {
+                std::cout << str << " = ";
+                std::istringstream term( str );
+                std::cout << berechneNaechstenTerm<int>( term, tabelle ) << "\n";
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Termzerleger
+        std::cout << "\n\nTest des Termzerlegers (gleiche Terme direkt aus dem Text berechnet):\n";
+        for( auto str : termeBruchberechner ) {
+            try {
+                std::cout << str << " = ";
+                std::cout << berechneNaechstenTerm<int>( std::string_view( str ) ) << "\n";      ///Ergebnisse und Fehlermeldungen sind dieselben wie mit std::istream.
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        std::cout << "0.5/1 0.5/2 + = " << berechneNaechstenTerm<double>( "0.5/1 0.5/2 +" ) << "\n";
+        std::cout << "5 5/2 - = " << berechneNaechstenTerm<long unsigned int>( "5 5/2 -" ) << "\n";
+        std::string wechselndeFaktoren;
+        for( int k = 0; k < 40; k++ )
+            wechselndeFaktoren += "3/2 2/3 ";
+        std::cout << "40 mal 3/2 2/3, 80 prod = " << berechneNaechstenTerm<long unsigned int>( wechselndeFaktoren + "80 prod" ) << "\n";   ///Auch ohne Vorzeichen bleibt das n-stellige Produkt gekürzt.
+        std::cout << "123456789012345678901234567890 2 * = " << berechneNaechstenTerm<Langzahl>( "123456789012345678901234567890 2 *" ) << "\n";
+        ///
+        static const std::string str4 = "1/1000 1/1000 + 1/1000 + 1/1000 + 1/1000 +";        ///Ohne Kürzen wäre der Nenner 1000^5 und würde int überlaufen lassen.
+        std::cout << str4 << " (KuerzeImmer) = ";
+        std::istringstream term4( str4 );
+        std::cout << berechneNaechstenTerm<int, KuerzeImmer>( term4 ) << "\n";                   ///Die Kürzungsstrategie kürzt nach jeder Rechenoperation,
+        std::cout << str4 << " (KuerzeAbBitbreite<16>) = ";
+        std::istringstream term5( str4 );
+        std::cout << berechneNaechstenTerm<int, KuerzeAbBitbreite<16>>( term5 ) << "\n";        ///oder erst, wenn Zähler oder Nenner breiter als 16 Bit sind.
+        ///
+        ///Test Berechnung zur Kompilierzeit
+        std::cout << "\n\nTest der Berechnung zur Kompilierzeit:\n";
+        constexpr Bruch<int> konstante = berechneKonstantenTerm<int>( "1/3 1/6 + k" );                   ///Der Term wird vollständig beim Kompilieren berechnet,
+        static_assert( konstante.getZaehler() == 1 && konstante.getNenner() == 2, "1/3 + 1/6 = 1/2" );   ///das Ergebnis kann in static_assert geprüft werden.
+        std::cout << "1/3 1/6 + k = " << konstante << "\n";
+        constexpr auto produkt = Bruch<long int>( 3, 100000 ) * Bruch<long int>( 100000, 3 );             ///Auch die Operatoren von Bruch sind constexpr.
+        std::cout << "100000/3 3/100000 * = " << produkt << "\n";
+        constexpr Bruch<int> harmonisch = berechneKonstantenTerm<int>( "1 1/2 1/3 1/4 4 Σ" );            ///Ebenso die n-stellige Summe.
+        static_assert( harmonisch.getZaehler() == 25 && harmonisch.getNenner() == 12, "1 + 1/2 + 1/3 + 1/4 = 25/12" );
+        std::cout << "1 1/2 1/3 1/4 4 Σ = " << harmonisch << "\n";
+        //constexpr Bruch<int> fehler = berechneKonstantenTerm<int>( "1 0 /" );                         //Fehler beim Kompilieren: Division durch 0
+        //constexpr Bruch<int> fehler = berechneKonstantenTerm<int>( "1 A +" );                         //Fehler beim Kompilieren: unbekanntes Zeichen
+        //constexpr Bruch<int> fehler = berechneKonstantenTerm<int>( "2147483647 2 *" );                //Fehler beim Kompilieren: Überlauf (zur Laufzeit wird nicht geprüft)
+        for( auto str : termeBruchberechner ) {
+            try {
+                std::cout << str << " = ";
+                std::cout << berechneKonstantenTerm<int>( str ) << "\n";                                ///Zur Laufzeit aufgerufen verhält sich die Funktion wie berechneNaechstenTerm.
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Termrechner
+        std::cout << "\n\nTest des Termrechners:\n";
+        Termrechner<long int> rechner;                                                              ///Ein Termrechner kann beliebig viele Terme nacheinander berechnen.
+        std::string tieferTerm;
+        for( int i = 1; i <= 20; i++ )
+            tieferTerm += "1/" + std::to_string( i ) + " ";
+        tieferTerm += std::string( 19, '*' );
+        std::cout << "Kapazitaet vorher: " << rechner.getKapazitaet() << "\n";
+        std::cout << "1/1 1/2 ... 1/20 * ... * = " << rechner.berechne( tieferTerm ) << "\n";       ///20 Zahlen passen nicht in den Puffer, der Stapel wächst
+        std::cout << "Kapazitaet nachher: " << rechner.getKapazitaet() << "\n";                     ///und behält seine Größe für die folgenden Terme.
+        std::cout << "1 5/4 + = " << rechner.berechne( "1 5/4 +" ) << "\n";
+        Termrechner<long int, KuerzeNie, 16, EigeneOperatoren> eigenerRechner;                      ///Eigene Rechenzeichen kommen über die Operatortabelle hinzu, ohne den Termrechner zu ändern.
+        std::cout << "1/2 2/3 mittel siebzehn + = " << eigenerRechner.berechne( "1/2 2/3 mittel siebzehn +" ) << "\n";
+        try {
+            std::cout << "1/2 mittel = ";
+            std::cout << eigenerRechner.berechne( "1/2 mittel" ) << "\n";
+        } catch( const std::runtime_error& e ) {
+            std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";                       ///Fehler: Die Stellenzahl kommt aus der Operatortabelle, auch für eigene Rechenzeichen.
+            std::cout << "\"" << e.what() << "\"\n" << std::endl;
+        }
+        {
+            Termstrom<long int, KuerzeNie, EigeneOperatoren> strom;                                 ///Auch im Termstrom, dort werden die Namen beim Zerschneiden in Stücke erkannt.
+            const std::string_view text = "1/2 2/3 mittel siebzehn +\n";
+            std::cout << "1/2 2/3 mittel siebzehn + (Stückgröße 1) =";
+            for( std::size_t i = 0; i < text.size(); i++ )
+                strom.lies( text.substr( i, 1 ), []( const auto& ergebnis ) {
+                    std::cout << " " << ergebnis.wert;
+                } );
+            std::cout << "\n";
+            strom.lies( "1/2 mittel\n", [&strom]( const auto& ergebnis ) {
+                std::string meldung;
+                strom.haengeFehlermeldungAn( meldung, ergebnis.fehler );
+                std::cout << "1/2 mittel (Termstrom) = [" << meldung << "]\n";
+            } );
+        }
+        ///
+        ///Test Infixnotation
+        std::cout << "\n\nTest der Infixnotation:\n";
+        static const std::string termeInfix[] = {
+            "(1/2 + 3/4) * -5/6",                   ///Klammern und Vorzeichen, "3/4" ist eine Zahl.
+            "1 - 2 - 3 * 4 / 6",                    ///Punkt vor Strich, gleichrangige Rechenzeichen von links nach rechts
+            "3 -5",                                 ///Nach einer Zahl ist "-5" eine Subtraktion, keine negative Zahl,
+            "2 * -3 - -(1/(2 + 2))",                ///vor einem Operanden ein Vorzeichen.
+            "1/(2 - 2)",                            ///Fehler: Division durch 0
+            "(1 + 2",                               ///Fehler: fehlende Klammer
+            "1 2 +",                                ///Fehler: Postfixnotation
+        };
+        for( const auto& str : termeInfix ) {
+            try {
+                std::cout << str << " = ";
+                std::cout << berechneInfixTerm<long int>( str ) << "\n";
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Berechnung ohne Exceptions
+        std::cout << "\n\nTest der Berechnung ohne Exceptions:\n";
+        for( auto str : termeBruchberechner ) {
+            const auto ergebnis = berechneNaechstenTermOhneAusnahme<int>( str );                       ///Statt einer Exception gibt es einen Fehlercode
+            std::cout << str << " = ";
+            if( ergebnis )
+                std::cout << ergebnis.wert << "\n";
+            else
+                std::cout << "Fehler " << static_cast<int>( ergebnis.fehler ) << " an Position " << ergebnis.position
+                          << ": " << getFehlermeldung( ergebnis.fehler ) << "\n";                       ///und die Position des Zeichens, an dem der Fehler festgestellt wurde.
+        }
+        {
+            Termrechner<unsigned long int> rechner;
+            const auto ergebnis = rechner.berechneOhneAusnahme( "1/4294967296 1/4294967296 *" );        ///Das Produkt der Nenner läuft über und wird 0, auch das ist ein Fehlercode.
+            std::cout << "1/4294967296 1/4294967296 * (unsigned long) = Fehler " << static_cast<int>( ergebnis.fehler ) << " an Position " << ergebnis.position << "\n";
+            const auto infix = rechner.berechneInfixOhneAusnahme( "1/4294967296 * 1/4294967296" );
+            std::cout << "1/4294967296 * 1/4294967296 (unsigned long, Infix) = Fehler " << static_cast<int>( infix.fehler ) << " an Position " << infix.position << "\n";
+        }
+        ///
+        ///Test Termprogramm
+        std::cout << "\n\nTest des Termprogramms:\n";
+        for( auto str : termeBruchberechner ) {
+            try {
+                std::cout << str << " = ";
+                const Termprogramm<int> programm( str );                                            ///Ohne Variablen ergibt das Programm dasselbe wie berechneNaechstenTerm,
+                std::cout << programm.berechne( {} ) << "\n";                                      ///nur Strukturfehler werden schon beim Übersetzen gemeldet.
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        const Termprogramm<int> programm( "x y + x y - k /", { "x", "y" } );                        ///Der Term wird einmal übersetzt
+        const std::vector<Bruch<int>> belegungen = { 1, 2, Bruch<int>( 2, 1 ), Bruch<int>( 3, 1 ), 5, 1 };
+        std::vector<Bruch<int>> ergebnisse;
+        programm.berechneAlle( belegungen.data(), belegungen.size() / 2, ergebnisse );               ///und für jede Belegung von x und y berechnet.
+        for( std::size_t i = 0; i < ergebnisse.size(); i++ )
+            std::cout << "x = " << belegungen[2 * i] << ", y = " << belegungen[2 * i + 1] << ": x y + x y - k / = " << ergebnisse[i] << "\n";
+        ///
+        ///Test Termgraph
+        std::cout << "\n\nTest des Termgraphen:\n";
+        {
+            const char* term = "x 1/3 + y * y x 1/3 + * + 1/3 1/7 + 1/7 1/3 + * +";                       ///"x 1/3 + y *" kommt zweimal vor, einmal mit vertauschten Faktoren,
+            const Termprogramm<long int> vorlage( term, { "x", "y" } );
+            const Termgraph<long int> graph( vorlage );                                                 ///"1/3 1/7 +" wird schon beim Übersetzen berechnet.
+            for( const std::vector<Bruch<long int>>& belegung : { std::vector<Bruch<long int>> { 1, 2 }, { Bruch<long int>( 2, 1 ), Bruch<long int>( 3, 1 ) }, { 5, 1 } } ) {
+                std::cout << "x = " << belegung[0] << ", y = " << belegung[1] << ": Termprogramm " << vorlage.berechne( belegung ) << ", Termgraph " << graph.berechne( belegung ) << "\n";
+            }
+            std::cout << "Operationen im Termprogramm: " << graph.getAnweisungenImProgramm() << ", im Termgraphen: " << graph.getKnoten().size()
+                      << ", gefaltet: " << graph.getGefaltet() << ", wiederverwendet: " << graph.getWiederverwendet() << ", Konstanten: " << graph.getKonstanten().size() << "\n";
+            try {
+                const Termgraph<long int> nullteiler( "x 1 0 / +", { "x" } );                             ///Die Division durch 0 wird nicht gefaltet,
+                std::cout << "Übersetzt mit " << nullteiler.getKnoten().size() << " Knoten\n";
+                nullteiler.berechne( { Bruch<long int>( 1 ) } );
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";                       ///sondern erst beim Berechnen gemeldet.
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Bruchspalte
+        std::cout << "\n\nTest der spaltenweisen Berechnung:\n";
+        std::vector<Bruchspalte<int>> spalten( 2, Bruchspalte<int>( 3 ) );                          ///Eine Spalte je Variable, eine Zeile je Belegung
+        for( std::size_t i = 0; i < 3; i++ ) {
+            spalten[0].setze( i, belegungen[2 * i] );
+            spalten[1].setze( i, belegungen[2 * i + 1] );
+        }
+        const auto spalte = berechneSpaltenweise( programm, spalten );
+        for( std::size_t i = 0; i < spalte.getGroesse(); i++ )
+            std::cout << "Zeile " << i << ": " << spalte.getBruch( i ) << "\n";                      ///Dieselben Ergebnisse wie mit dem Termprogramm.
+        std::cout << "Summe der Zeilen: " << summeDerSpalte( spalte ) << "\n";
+        std::cout << "Produkt der Zeilen: " << produktDerSpalte( spalte ) << "\n";
+        try {
+            berechneSpaltenweise( Termprogramm<int>( "x y /", { "x", "y" } ), { Bruchspalte<int>( 2 ), Bruchspalte<int>( 2 ) } );
+        } catch( const std::runtime_error& e ) {
+            std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";                       ///Fehler: Division durch 0 in einer Zeile
+            std::cout << "\"" << e.what() << "\"\n" << std::endl;
+        }
+        ///
+        ///Test Instrumentierung
+        std::cout << "\n\nTest der Instrumentierung:\n";
+        if constexpr( instrumentiert ) {
+            setzeMesswerteZurueck();
+            std::cout << "1/2 3/4 + 5/6 * = " << berechneNaechstenTerm<int>( "1/2 3/4 + 5/6 *" ) << "\n";
+            std::cout << "Additionen: " << messwerte.zaehler[static_cast<std::size_t>( Zaehler::Addition )] << "\n";
+            std::cout << "Multiplikationen: " << messwerte.zaehler[static_cast<std::size_t>( Zaehler::Multiplikation )] << "\n";
+            std::cout << "Operanden mit 3 Bit: " << messwerte.bitbreiten[3] << "\n";                ///3/4 und 5/6, die Summe ist ungekürzt 10/8
+            std::cout << "Terme mit Stapeltiefe 2: " << messwerte.stapeltiefen[2] << "\n";
+            setzeMesswerteZurueck();
+            std::cout << "1 2 3 3 Σ 4 2 prod = " << berechneNaechstenTerm<int>( "1 2 3 3 Σ 4 2 prod" ) << "\n";
+            std::cout << "Summen: " << messwerte.zaehler[static_cast<std::size_t>( Zaehler::Summe )]                ///Auch die n-stelligen Rechenzeichen werden gezählt,
+                      << ", Produkte: " << messwerte.zaehler[static_cast<std::size_t>( Zaehler::Produkt )] << "\n";
+            std::cout << "Operanden mit 2 Bit: " << messwerte.bitbreiten[2] << "\n";                ///mit ihren N Operanden (2 und 3), ohne die Anzahl.
+        } else
+            std::cout << "Die Instrumentierung ist nicht einkompiliert (-DBRUCHRECHNER_INSTRUMENTIERUNG).\n";
+        ///
+        ///Test Überlaufschutz
+        std::cout << "\n\nTest des Überlaufschutzes:\n";
+        static const std::string termeUeberlauf[] = {
+            "1/2 1/3 +",                                    ///Passt in 64 Bit und wird mit long int berechnet.
+            "4294967296 4294967296 *",                      ///2^64 passt nicht mehr in long int, der Term wird mit __int128 neu berechnet.
+            "-9223372036854775808 -1 /",                    ///Auch der Überlauf bei der Division wird erkannt.
+            "100000000000000000000 3 /",                    ///Eine Zahl, die schon beim Einlesen zu groß ist, wird ebenfalls erkannt.
+            "18446744073709551616 18446744073709551616 * 18446744073709551616 *",  ///Reichen auch 128 Bit nicht, wird mit Langzahl gerechnet.
+        };
+        for( auto str : termeUeberlauf ) {
+            try {
+                std::cout << str << " = ";
+                std::cout << berechneTermMitUeberlaufschutz( str ) << "\n";
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Langzahl
+        std::cout << "\n\nTest des Moduls Langzahl:\n";
+        static const std::string termeLangzahl[] = {
+            "1/3 1/6 +",                                                            ///Kleine Zahlen liegen direkt im Objekt.
+            "340282366920938463463374607431768211456 -1/3 *",                       ///2^128 / -3
+            "123456789012345678901234567890/987654321098765432109876543210",        ///Beim Kürzen wird der ggT der Langzahlen bestimmt.
+            "99999999999999999999999999999/7 1/99999999999999999999999999999 * k",  ///Über Kreuz kürzen zurück auf eine kleine Zahl
+            "1/0",                                                                  ///Fehler: Division durch 0
+        };
+        for( auto str : termeLangzahl ) {
+            try {
+                std::cout << str << " = ";
+                std::istringstream term( str );
+                std::cout << berechneNaechstenTerm<Langzahl>( term ) << "\n";
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Baumreduktion
+        std::cout << "\n\nTest der Baumreduktion:\n";
+        std::vector<Bruch<long int>> stammbrueche;
+        for( long int k = 1; k <= 1000; k++ )
+            stammbrueche.emplace_back( k * ( k + 1 ), 1 );                                          ///1/(k(k+1)) = 1/k - 1/(k+1), die Summe ist 1 - 1/1001.
+        std::cout << "Summe 1/(k(k+1)) fuer k = 1 bis 1000 = " << summiereBaum( stammbrueche.data(), stammbrueche.size(), 4 ) << "\n";    ///Die Teilsummen werden auf 4 Threads berechnet
+        std::cout << "ohne Threads = " << summiereBaum( stammbrueche.data(), stammbrueche.size(), 1 ) << "\n";                          ///und ergeben dasselbe wie ohne Threads.
+        std::vector<Bruch<Langzahl>> teleskop;
+        for( int k = 1; k <= 1000; k++ )
+            teleskop.emplace_back( Langzahl( k + 1 ), Langzahl( k ) );
+        Arbeitspool pool( 3 );                                                                      ///Ein Arbeitspool kann für viele Reduktionen genutzt werden.
+        std::cout << "Produkt k/(k+1) fuer k = 1 bis 1000 = " << multipliziereBaum( teleskop.data(), teleskop.size(), pool, 16 ) << "\n";   ///Auch mit Langzahl.
+        std::vector<Bruch<Langzahl>> zweierpotenzen( 200, Bruch<Langzahl>( 2 ) );
+        std::cout << "Produkt von 200 mal 2 = " << multipliziereBaum( zweierpotenzen.data(), zweierpotenzen.size(), pool, 16 ) << "\n";
+        std::vector<Bruch<unsigned long int>> wechselnd;
+        for( int k = 0; k < 80; k++ )
+            wechselnd.emplace_back( k % 2 ? 3u : 2u, k % 2 ? 2u : 3u );                                ///3/2 und 2/3 im Wechsel, ungekürzt wäre 6^40 zu groß.
+        std::cout << "Produkt von 40 mal 3/2 * 2/3 (vorzeichenlos) = " << multipliziereBaum( wechselnd.data(), wechselnd.size(), pool, 16 ) << "\n";
+        try {
+            std::vector<Bruch<Geprueft<long int>>> gross( 100, Bruch<Geprueft<long int>>( 1000 ) );
+            multipliziereBaum( gross.data(), gross.size(), pool, 8 );
+        } catch( const Ueberlauf& e ) {
+            std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";                       ///Fehler: Überlauf in einem Teilbaum auf einem anderen Thread
+            std::cout << "\"" << e.what() << "\"\n" << std::endl;
+        }
+        ///
+        ///Test Modularrechner
+        std::cout << "\n\nTest des Modularrechners:\n";
+        std::string harmonischerTerm = "1";
+        for( int k = 2; k <= 100; k++ )
+            harmonischerTerm += " 1/" + std::to_string( k ) + " +";
+        static const std::string termeModular[] = {
+            "1/3 1/6 +",                                                            ///Das Ergebnis wird aus den Resten modulo mehrerer Primzahlen rekonstruiert,
+            "-7/12 5/-18 - 3 *",                                                    ///auch negative.
+            "123456789012345678901234567890 987654321098765432109876543210 *",      ///Große Zahlen brauchen mehr Primzahlen.
+            "1 1/2 1/3 1/4 4 Σ 2 /",
+            harmonischerTerm,                                                       ///Ungekürzt hätte der Nenner 525 Bit, gekürzt nur 132 Bit: Das Ergebnis steht fest, bevor die Schranke erreicht ist.
+            "1/1 0/1 /",                                                            ///Fehler: Division durch 0 (Rückfall auf die exakte Berechnung)
+            "1 1 0 / /",                                                            ///Fehler: Division durch 0 im Divisor, auch wenn der Zähler des Quotienten 0 wird
+            "1 +",                                                                  ///Fehler: zu wenig Zahlen (schon beim Übersetzen)
+        };
+        for( const auto& str : termeModular ) {
+            try {
+                std::cout << ( str.size() > 70 ? str.substr( 0, 30 ) + " ... " + str.substr( str.size() - 20 ) : str ) << " = ";
+                Modularbericht bericht;
+                const Bruch<Langzahl> ergebnis = berechneTermModular( str, 2, &bericht );
+                std::cout << ergebnis << " (" << bericht.primzahlen << " Primzahlen, Schranke " << bericht.schranke << " Bit"
+                          << ( bericht.vorzeitig ? ", vorzeitig bestätigt" : "" ) << ")\n";
+                const Bruch<Langzahl> exakt = berechneNaechstenTerm<Langzahl>( str );                               ///Das Ergebnis ist dasselbe wie bei exakter Berechnung.
+                if( ergebnis.getZaehler() != exakt.getZaehler() || ergebnis.getNenner() != exakt.getNenner() )
+                    std::cout << "Abweichung von der exakten Berechnung!\n";
+            } catch( const std::runtime_error& e ) {
+                std::cout << "\nBei der Berechnung ist ein Fehler aufgetreten:\n";
+                std::cout << "\"" << e.what() << "\"\n" << std::endl;
+            }
+        }
+        ///
+        ///Test Termstrom
+        std::cout << "\n\nTest des Termstroms:\n";
+        static const std::string stromText = "12/-34 -5/6 + 7 *\n1 2 3 3 sum 1/2 -\n3 4 x\n-1 -2-\n1 2";    ///Mehrere Zeilen, eine davon fehlerhaft, die letzte ohne Zeilenumbruch
+        for( std::size_t stueckgroesse : { std::size_t( 1 ), std::size_t( 3 ), stromText.size() } ) {
+            Termstrom<long int> strom;                                                              ///Der Text wird in Stücken übergeben, die Zahlen und "sum" durchschneiden.
+            std::cout << "Stückgröße " << stueckgroesse << ":";
+            std::size_t zeile = 0;
+            auto pruefe = [&]( const Termergebnis<Bruch<long int>>& ergebnis ) {
+                std::string_view rest( stromText );
+                for( std::size_t i = 0; i < zeile; i++ )
+                    rest.remove_prefix( rest.find( '\n' ) + 1 );
+                const auto erwartet = berechneNaechstenTermOhneAusnahme<long int>( rest.substr( 0, rest.find( '\n' ) ) );
+                zeile++;
+                if( ergebnis ) {
+                    std::cout << " " << ergebnis.wert;
+                    if( !erwartet || ergebnis.wert.getZaehler() != erwartet.wert.getZaehler() || ergebnis.wert.getNenner() != erwartet.wert.getNenner() )
+                        std::cout << " (Abweichung!)";
+                } else {
+                    std::string meldung;
+                    strom.haengeFehlermeldungAn( meldung, ergebnis.fehler );
+                    std::cout << " [" << meldung << " an Position " << ergebnis.position << "]";        ///Die Fehlerposition zählt ab dem Anfang der Zeile, nicht des Stücks.
+                    if( erwartet || ergebnis.position != erwartet.position )
+                        std::cout << " (Abweichung!)";
+                }
+            };
+            for( std::size_t i = 0; i < stromText.size(); i += stueckgroesse )
+                strom.lies( std::string_view( stromText ).substr( i, stueckgroesse ), pruefe );
+            strom.beende( pruefe );
+            std::cout << "\n";
+        }
+        {
+            Termstrom<long int, KuerzeImmer> strom;
+            std::size_t laengsterRest = 0;
+            Bruch<long int, KuerzeImmer> summe;
+            strom.lies( "1/7 1", []( const auto& ) {} );
+            for( int i = 0; i < 100000; i++ ) {                                                     ///Ein Term aus 200000 Summanden, jedes Stück endet mitten in einer Zahl,
+                strom.lies( "/7 + 1/-7 + 1", []( const auto& ) {} );
+                laengsterRest = std::max( laengsterRest, strom.getRestlaenge() );
+            }
+            strom.lies( "/7 +\n", [&]( const auto & ergebnis ) {
+                summe = ergebnis.wert;
+            } );
+            std::cout << "1/7 1/7 + 1/-7 + ... 1/7 + = " << summe << ", längster Rest zwischen zwei Stücken: " << laengsterRest << " Zeichen\n";   ///aber nie mehr als eine Zahl im Speicher.
+        }
+        ///
+        ///Test Ergebniscache
+        std::cout << "\n\nTest des Ergebniscaches:\n";
+        {
+            Ergebniscache cache( 1 << 20 );
+            std::string ausgabeCache;
+            for( const char* str : { "1/2 1/3 +", " 1/2\t1/3  + ", "1/2 1/3+", "3 4 x", "3  4 x" } ) {  ///Nur der Leerraum zwischen den Zeichen wird vereinheitlicht,
+                ausgabeCache.clear();                                                               ///"1/2 1/3+" ist ein anderer Schlüssel.
+                berechneZeile( str, ausgabeCache, false, false, &cache );                          ///Auch Fehler werden gespeichert.
+                std::cout << "\"" << str << "\" = " << ausgabeCache.substr( 0, ausgabeCache.find( '\n', ausgabeCache.find( '\n' ) + 1 ) ) << "\n";
+            }
+            std::cout << "Treffer: " << cache.getTreffer() << ", Fehlgriffe: " << cache.getFehlgriffe() << ", Einträge: " << cache.getAnzahl() << "\n";
+            Ergebniscache kleinerCache( 400, 1 );                                                  ///Ein kleines Budget reicht nur für wenige Einträge,
+            for( int i = 0; i < 10; i++ ) {
+                ausgabeCache.clear();
+                berechneZeile( std::to_string( i ) + " 1 +", ausgabeCache, false, false, &kleinerCache );
+            }
+            ausgabeCache.clear();
+            berechneZeile( "9 1 +", ausgabeCache, false, false, &kleinerCache );                  ///der zuletzt genutzte bleibt erhalten.
+            std::cout << "Verdrängt: " << kleinerCache.getVerdraengt() << ", Einträge: " << kleinerCache.getAnzahl() << ", belegt: " << kleinerCache.getBelegt()
+                      << " Byte, Treffer: " << kleinerCache.getTreffer() << "\n";
+        }
+        ///
+        ///Test Stapelverarbeitung
+        std::cout << "\n\nTest der Stapelverarbeitung:\n";
+        static const char dateiname[] = "BruchrechnerTest_Stapel.txt";
+        {
+            std::ofstream datei( dateiname );
+            for( int i = 1; i <= 5; i++ )
+                datei << i << "/" << i + 1 << " 1/" << i * ( i + 1 ) << " +\n";     ///Eine Zeile pro Term
+            datei << "1 +\n";                                                       ///Fehlermeldungen erscheinen an der Stelle ihrer Zeile.
+            datei << "1/2 1/2 +";                                                   ///Die letzte Zeile braucht keinen Zeilenumbruch.
+        }
+        std::cout.flush();                                                          //Der Ausgabepuffer schreibt direkt in stdout, vorher muss std::cout geleert werden.
+        Ausgabepuffer ausgabe( STDOUT_FILENO );
+        berechneDatei( dateiname, ausgabe, 3, false );                              ///Die Ergebnisse bleiben trotz mehrerer Threads in der Reihenfolge der Eingabe.
+        std::remove( dateiname );
     } catch( const std::exception& e ) {
         std::cout << "\nBei der Berechnung ist ein unerwarteter Fehler aufgetreten:\n";
         std::cout <<  "\"" << e.what() << "\"\n" << std::endl;